@@ -237,6 +237,9 @@ namespace
 {
   bool g_print_ip = false;
   bool g_print_speedup = true;
+
+  // the command line, for benchmarks with additional options
+  std::vector<std::string> g_args;
 }
 
 template <class T, class B, class Ref = NoRef>
@@ -908,7 +911,7 @@ usage()
 int
 main(int argc, char** argv)
 {
-  std::vector<std::string> args;
+  std::vector<std::string>& args = g_args;
   for (int i = 0; i < argc; ++i)
     args.emplace_back(argv[i]);
 
@@ -7,10 +7,21 @@
 #include <climits>
 #include <complex>
 
+template <class T>
+  [[gnu::always_inline]]
+  inline T
+  muladd(const T& a, const T& b, const T& c)
+  {
+    if constexpr (requires { fma(a, b, c); })
+      return fma(a, b, c);
+    else
+      return a * b + c;
+  }
+
 template <int Special>
   struct Benchmark<Special>
   {
-    static constexpr Info<2> info = {"Latency", "Throughput"};
+    static constexpr Info<4> info = {"Latency", "Throughput", "FMA Latency", "FMA Throughput"};
 
     template <class T>
       [[gnu::flatten]]
@@ -50,6 +61,23 @@ template <int Special>
 		    auto d4 = data[4]; vir::fake_modify(b, d4); T r4 = d4 * b;
 		    auto d5 = data[5]; vir::fake_modify(b, d5); T r5 = d5 * b;
 		    vir::fake_read(r0, r1, r2, r3, r4, r5);
+		  }),
+	  0.25 * time_median([&] [[gnu::always_inline]] {
+		   auto d = data[0];
+		   vir::fake_modify(d); T r = muladd(d, b, d);
+		   vir::fake_modify(d);   r = muladd(d, r, d);
+		   vir::fake_modify(d);   r = muladd(d, r, d);
+		   vir::fake_modify(d);   r = muladd(d, r, d);
+		   b = r;
+		 }),
+	  1./6. * time_median([&] [[gnu::always_inline]] {
+		    auto d0 = data[0]; vir::fake_modify(b, d0); T r0 = muladd(d0, b, d0);
+		    auto d1 = data[1]; vir::fake_modify(b, d1); T r1 = muladd(d1, b, d1);
+		    auto d2 = data[2]; vir::fake_modify(b, d2); T r2 = muladd(d2, b, d2);
+		    auto d3 = data[3]; vir::fake_modify(b, d3); T r3 = muladd(d3, b, d3);
+		    auto d4 = data[4]; vir::fake_modify(b, d4); T r4 = muladd(d4, b, d4);
+		    auto d5 = data[5]; vir::fake_modify(b, d5); T r5 = muladd(d5, b, d5);
+		    vir::fake_read(r0, r1, r2, r3, r4, r5);
 		  })
 	};
       }
@@ -0,0 +1,60 @@
+#!/bin/bash
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright © 2026 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+#                  Matthias Kretz <m.kretz@gsi.de>
+
+# Runs the complex-abs and complex-norm benchmarks for VIR_PATCH_IMPROVE_CX=1, 2, and 3 and prints
+# the fastest strategy per value-type and width, together with the summed latency and throughput
+# of every strategy. The output is also written to improve_cx_table/<arch>-<cpu>.out, the
+# measurements the table in __improve_cx_strategy (include/bits/simd_complex.h) is based on.
+#
+# Usage: improve_cx_table.sh [<arch>...]    (default: native)
+
+dir="${0%/*}"
+[[ "$dir" == '.' ]] && dir="$PWD"
+cd "$dir"
+
+if (( $# > 1 )); then
+  for arch in "$@"; do
+    "$0" "$arch" || exit 1
+  done
+  exit 0
+fi
+
+arch=${1:-native}
+benchmarks="complex-abs complex-norm"
+cpu=$(grep -m1 '^model name' /proc/cpuinfo | sed 's/^.*: //; s/[^A-Za-z0-9]\+/_/g')
+mkdir -p improve_cx_table
+out=improve_cx_table/$arch-$cpu.out
+
+for b in $benchmarks; do
+  for v in 1 2 3; do
+    make -s bin/$b-improve_cx$v-$arch || exit 1
+  done
+done
+
+./benchmark-mode.sh on
+echo "# $arch on $cpu, $($CXX --version | head -n1)" | tee $out
+for b in $benchmarks; do
+  for v in 1 2 3; do
+    # rows look like "cxfp32, 4      <latency>      <throughput>"
+    bin/$b-improve_cx$v-$arch --no-speedup --no-cxctgus \
+      | awk -v v=$v '/^cx/ && $2 ~ /^[0-9]+$/ { print $1 $2, v, $(NF-1) + $NF }'
+  done
+done | awk '
+  { score[$1 " " $2] += $3; keys[$1] = 1 }
+  END {
+    n = asorti(keys, sorted)
+    for (i = 1; i <= n; ++i) {
+      k = sorted[i]; best = 0
+      for (v = 1; v <= 3; ++v)
+        if (best == 0 || score[k " " v] < score[k " " best])
+          best = v
+      printf "%-12s strategy %d  (%.3g / %.3g / %.3g cycles)\n", k, best,
+             score[k " 1"], score[k " 2"], score[k " 3"]
+    }
+  }' | tee -a $out
+./benchmark-mode.sh off
+
+# vim: tw=0 si
@@ -32,8 +32,9 @@ constexpr auto aligned = std::simd::flag_aligned;
 template <int Special>
   struct Benchmark<Special>
   {
-    static constexpr Info<4> info
-      = {"Random Mask", "Epilogue Mask", "Transform", "read-modify-write"};
+    static constexpr Info<6> info
+      = {"Random Mask", "Epilogue Mask", "Partial Store", "Transform", "read-modify-write",
+         "RMW flag"};
 
     template <typename T>
       static constexpr bool accept = std::default_initializable<T>
@@ -41,7 +42,7 @@ template <int Special>
                                        and size_v<T> <= simd::vec<value_type_t<T>>::size();
 
     template <class V>
-      static Times<4>
+      static Times<6>
       run()
       {
         using T = value_type_t<V>;
@@ -98,6 +99,17 @@ template <int Special>
                 store<V>(obj, make_mask(), 0 * sizeof(V));
               }
           }),
+          time_mean2<800'000>([&](auto& need_more)
+          {
+            V obj = {};
+            while (need_more)
+              {
+                T* ptr = reinterpret_cast<T*>(mem);
+                asm("":"+m,g,v,x"(obj));
+                simd::partial_store(obj, ptr, need_more.it % V::size());
+                asm(""::"m"(*mem));
+              }
+          }),
           time_mean2<1'000'000>([&](auto& need_more)
           {
             while (need_more)
@@ -129,6 +141,22 @@ template <int Special>
                   out = simd::select(obj > T(std::numeric_limits<T>::max() / 2), obj, out);
                 simd::unchecked_store(out, output.begin() + i, output.end(), aligned);
               }
+          }),
+          time_mean2<1'000'000>([&](auto& need_more)
+          {
+            constexpr auto rmw = aligned | simd::__flag_read_modify_write;
+            while (need_more)
+              {
+                asm ("":"+m"(output), "+m"(input));
+                size_t i = (need_more.it * V::size()) % 1024;
+                V obj = simd::unchecked_load<V>(input.begin() + i, input.end(), aligned);
+                if constexpr (std::is_floating_point_v<T>)
+                  simd::unchecked_store(obj, output.begin() + i, output.end(), obj > T(0.5), rmw);
+                else if constexpr (std::is_signed_v<T>)
+                  simd::unchecked_store(obj, output.begin() + i, output.end(), obj >= T(), rmw);
+                else
+                  simd::unchecked_store(obj, output.begin() + i, output.end(), obj > T(std::numeric_limits<T>::max() / 2), rmw);
+              }
           })
         };
       }
@@ -0,0 +1,381 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+// Accuracy and throughput report for the math functions.
+//
+// Every function is called with the precise, finite-math, and fast-math policy (math_precision<1>,
+// math_precision<1> + finite-math-only, and fast_math). Therefore this file is compiled without
+// -ffast-math and a single binary covers all kernel variants of one math ABI (-march). The results
+// are compared against a long double reference (or __float128 with -DREF_FLOAT128 -lquadmath).
+//
+// Unary float functions are checked exhaustively. Double and multi-argument functions are checked
+// on dense pseudo-random samples: half of them are random bit patterns (all binades, subnormals,
+// inf, NaN), the other half are in the interesting range [2^-32, 2^32).
+//
+// The finite and fast policies only see finite inputs with a finite reference result. A result
+// that is NaN/inf where the reference is not (or vice versa) counts as a mismatch, not as an ULP
+// error.
+//
+// Additional options:
+//   --stride N    check only every N-th float (default: 1, i.e. all 2^32 values)
+//   --samples N   number of samples for double and multi-argument functions (default: 2^24)
+//   --threads N   number of threads for the accuracy sweep (default: all CPUs)
+//   <name>        only check the given function(s); hypot3 is the 3-argument hypot
+
+#include "bench.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+#if REF_FLOAT128
+#include <quadmath.h>
+#endif
+
+namespace
+{
+#if REF_FLOAT128
+  using Ref = __float128;
+
+#define REF(fn) [](auto... x) -> Ref { return fn##q(Ref(x)...); }
+#else
+  using Ref = long double;
+
+#define REF(fn) [](auto... x) -> Ref { return std::fn(Ref(x)...); }
+#endif
+
+#define SIMD(fn) [] <simd::_TargetTraits P> (const auto&... x) { return simd::fn<P>(x...); }
+
+  /// The sin (I = 0) or cos (I = 1) result of the sincos extension.
+#define SINCOS(I)                                                                                  \
+  [] <simd::_TargetTraits P, typename V> (const V& x) {                                            \
+    std::array<V, 2> r;                                                                            \
+    simd::sincos<P>(x, &r[0], &r[1]);                                                              \
+    return r[I];                                                                                   \
+  }
+
+  constexpr simd::_TargetTraits precise = simd::math_precision<1>;
+
+  constexpr simd::_TargetTraits finite
+    = {simd::_ArchTraits(precise), simd::_OptTraits{precise._M_build_flags | 0b100}};
+
+  constexpr simd::_TargetTraits fast = simd::fast_math;
+
+  constexpr std::array policy_names = {"precise", "finite", "fast"};
+
+  constexpr int chunk_size = 4096;
+
+  unsigned g_stride = 1;
+  long g_samples = 1 << 24;
+  unsigned g_threads = std::thread::hardware_concurrency();
+
+  template <int Arity, typename SimdFn, typename RefFn>
+    struct Function
+    {
+      static constexpr int arity = Arity;
+      const char* name;
+      SimdFn simd_fn;
+      RefFn ref_fn;
+    };
+
+  template <int Arity>
+    constexpr auto
+    make_function(const char* name, auto simd_fn, auto ref_fn)
+    { return Function<Arity, decltype(simd_fn), decltype(ref_fn)>{name, simd_fn, ref_fn}; }
+
+#define ULP_FUN1(fn) make_function<1>(#fn, SIMD(fn), REF(fn))
+#define ULP_FUN2(fn) make_function<2>(#fn, SIMD(fn), REF(fn))
+
+  template <typename T, int Arity>
+    using Chunk = std::array<std::array<T, chunk_size>, Arity>;
+
+  struct Stats
+  {
+    double max_ulp = 0;
+    double sum_ulp = 0;
+    long count = 0;
+    long mismatches = 0;
+    std::array<double, 3> worst = {};
+
+    void
+    merge(const Stats& other)
+    {
+      if (other.max_ulp > max_ulp)
+        {
+          max_ulp = other.max_ulp;
+          worst = other.worst;
+        }
+      sum_ulp += other.sum_ulp;
+      count += other.count;
+      mismatches += other.mismatches;
+    }
+  };
+
+  /// xorshift64: fast, deterministic, and good enough for picking inputs
+  struct Rng
+  {
+    std::uint64_t state;
+
+    std::uint64_t
+    operator()()
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      return state;
+    }
+  };
+
+  template <typename T>
+    T
+    random_input(Rng& rng)
+    {
+      using U = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+      const std::uint64_t bits = rng();
+      if (bits & 1)
+        return std::bit_cast<T>(static_cast<U>(rng()));
+      const int e = int((bits >> 1) % 64) - 32;
+      const T m = T(1) + T(rng() >> 12) * T(0x1p-52);
+      return std::ldexp((bits >> 8) & 1 ? -m : m, e);
+    }
+
+  template <typename T>
+    bool
+    is_exhaustive(int arity)
+    { return arity == 1 && std::is_same_v<T, float>; }
+
+  template <typename T>
+    long
+    chunk_count(int arity)
+    {
+      if (is_exhaustive<T>(arity))
+        return ((1l << 32) / g_stride + chunk_size - 1) / chunk_size;
+      else
+        return (g_samples + chunk_size - 1) / chunk_size;
+    }
+
+  template <typename T, int Arity>
+    void
+    fill_chunk(Chunk<T, Arity>& in, long c)
+    {
+      if (is_exhaustive<T>(Arity))
+        for (int i = 0; i < chunk_size; ++i)
+          in[0][i] = std::bit_cast<T>(std::uint32_t((c * chunk_size + i) * g_stride));
+      else
+        {
+          Rng rng{std::uint64_t(c + 1) * 0x9e3779b97f4a7c15u};
+          for (auto& arg : in)
+            for (T& x : arg)
+              x = random_input<T>(rng);
+        }
+    }
+
+  /**
+   * Returns the error of @p r in ULP of @p ref (rounded to T), or -1 if exactly one of them is
+   * NaN/inf.
+   */
+  template <typename T>
+    double
+    ulp_error(T r, Ref ref)
+    {
+      using L = std::numeric_limits<T>;
+      const T ref_t = T(ref);
+      if (!std::isfinite(ref_t) || !std::isfinite(r))
+        return (r == ref_t || (std::isnan(r) && std::isnan(ref_t))) ? 0 : -1;
+      const Ref abs_ref = ref < 0 ? -ref : ref;
+      int e = ref_t == 0 ? L::min_exponent - 1 : std::ilogb(ref_t);
+      // ref_t was rounded up to the next binade
+      if (Ref(std::abs(ref_t)) > abs_ref && std::abs(ref_t) == std::scalbn(T(1), e))
+        --e;
+      const T ulp = std::scalbn(T(1), std::max(e, L::min_exponent - 1) - (L::digits - 1));
+      const Ref diff = Ref(r) - ref;
+      return double((diff < 0 ? -diff : diff) / Ref(ulp));
+    }
+
+  template <simd::_TargetTraits P, typename V, int Arity>
+    [[gnu::always_inline]]
+    inline V
+    apply_simd(const auto& fun, const Chunk<typename V::value_type, Arity>& in, int i)
+    {
+      return [&]<int... A>(std::integer_sequence<int, A...>) {
+        return fun.simd_fn.template operator()<P>(simd::unchecked_load<V>(&in[A][i], V::size())...);
+      }(std::make_integer_sequence<int, Arity>());
+    }
+
+  template <simd::_TargetTraits P, typename T, int Arity>
+    void
+    check_policy(const auto& fun, const Chunk<T, Arity>& in,
+                 const std::array<Ref, chunk_size>& ref, Stats& stats, bool only_finite)
+    {
+      using V = simd::vec<T>;
+      for (int i = 0; i < chunk_size; i += V::size())
+        {
+          const V r = apply_simd<P, V, Arity>(fun, in, i);
+          for (int j = 0; j < V::size(); ++j)
+            {
+              if (only_finite)
+                {
+                  bool finite_inputs = std::isfinite(T(ref[i + j]));
+                  for (const auto& arg : in)
+                    finite_inputs &= std::isfinite(arg[i + j]);
+                  if (!finite_inputs)
+                    continue;
+                }
+              const double err = ulp_error(T(r[j]), ref[i + j]);
+              ++stats.count;
+              if (err < 0)
+                ++stats.mismatches;
+              else
+                {
+                  stats.sum_ulp += err;
+                  if (err > stats.max_ulp)
+                    {
+                      stats.max_ulp = err;
+                      for (int a = 0; a < Arity; ++a)
+                        stats.worst[a] = in[a][i + j];
+                    }
+                }
+            }
+        }
+    }
+
+  /// bench.h pins the main thread to CPU 0 with FIFO scheduling; the workers must not inherit that
+  void
+  unpin_thread()
+  {
+    sched_param sp = {};
+    sched_setscheduler(0, SCHED_OTHER, &sp);
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (unsigned i = 0; i < std::thread::hardware_concurrency(); ++i)
+      CPU_SET(i, &cpuset);
+    sched_setaffinity(0, sizeof(cpuset), &cpuset);
+  }
+
+  template <typename T, int Arity>
+    std::array<Stats, 3>
+    check_accuracy(const auto& fun)
+    {
+      const long chunks = chunk_count<T>(Arity);
+      std::atomic<long> next_chunk = 0;
+      std::array<Stats, 3> total = {};
+      std::mutex total_mutex;
+      std::vector<std::jthread> workers;
+      for (unsigned t = 0; t < std::max(1u, g_threads); ++t)
+        workers.emplace_back([&] {
+          unpin_thread();
+          std::array<Stats, 3> stats = {};
+          Chunk<T, Arity> in;
+          std::array<Ref, chunk_size> ref;
+          for (long c = next_chunk++; c < chunks; c = next_chunk++)
+            {
+              fill_chunk<T, Arity>(in, c);
+              for (int i = 0; i < chunk_size; ++i)
+                ref[i] = [&]<int... A>(std::integer_sequence<int, A...>) {
+                  return fun.ref_fn(in[A][i]...);
+                }(std::make_integer_sequence<int, Arity>());
+              check_policy<precise, T, Arity>(fun, in, ref, stats[0], false);
+              check_policy<finite, T, Arity>(fun, in, ref, stats[1], true);
+              check_policy<fast, T, Arity>(fun, in, ref, stats[2], true);
+            }
+          std::lock_guard lock(total_mutex);
+          for (int p = 0; p < 3; ++p)
+            total[p].merge(stats[p]);
+        });
+      workers.clear();
+      return total;
+    }
+
+  template <simd::_TargetTraits P, typename T, int Arity>
+    double
+    cycles_per_value(const auto& fun, const Chunk<T, Arity>& in)
+    {
+      using V = simd::vec<T>;
+      return time_mean<64>([&] {
+               for (int i = 0; i < chunk_size; i += V::size())
+                 vir::fake_read(apply_simd<P, V, Arity>(fun, in, i));
+             }) / chunk_size;
+    }
+
+  template <typename T, int Arity>
+    void
+    report(const auto& fun)
+    {
+      const std::array<Stats, 3> stats = check_accuracy<T, Arity>(fun);
+
+      // time the same pseudo-random inputs for all policies (the exhaustive float sweep would
+      // start with subnormals)
+      Chunk<T, Arity> in;
+      Rng rng{0x2545f4914f6cdd1du};
+      for (auto& arg : in)
+        for (T& x : arg)
+          x = random_input<T>(rng);
+      const std::array<double, 3> cycles = {
+        cycles_per_value<precise, T, Arity>(fun, in),
+        cycles_per_value<finite, T, Arity>(fun, in),
+        cycles_per_value<fast, T, Arity>(fun, in)
+      };
+
+      for (int p = 0; p < 3; ++p)
+        {
+          const Stats& s = stats[p];
+          std::cout << std::setw(8) << fun.name << std::setw(8)
+                    << (std::is_same_v<T, float> ? "float" : "double") << std::setw(4)
+                    << simd::vec<T>::size() << std::setw(9) << policy_names[p]
+                    << std::setprecision(3) << std::setw(12) << s.max_ulp << std::setw(12)
+                    << (s.count > s.mismatches ? s.sum_ulp / (s.count - s.mismatches) : 0.)
+                    << std::setw(12) << s.mismatches << std::setw(12) << s.count
+                    << std::setw(12) << cycles[p] << "   (";
+          for (int a = 0; a < Arity; ++a)
+            std::cout << (a ? ", " : "") << std::hexfloat << s.worst[a] << std::defaultfloat;
+          std::cout << ")\n";
+        }
+    }
+
+  // Only the functions implemented in libsimd (the others have no precise and fast kernels yet).
+  // Add more with ULP_FUN1/ULP_FUN2 as they are implemented. sin and cos are the two results of
+  // sincos; they are the unary functions that take the exhaustive float path.
+  constexpr auto functions = std::tuple{
+    make_function<1>("sin", SINCOS(0), REF(sin)),
+    make_function<1>("cos", SINCOS(1), REF(cos)),
+    ULP_FUN2(hypot),
+    make_function<3>("hypot3", SIMD(hypot), [](auto x, auto y, auto z) {
+                       return REF(sqrt)(Ref(x) * x + Ref(y) * y + Ref(z) * z);
+                     })
+  };
+}
+
+void
+bench_main()
+{
+  std::vector<std::string> names;
+  for (std::size_t i = 1; i < g_args.size(); ++i)
+    {
+      const std::string& a = g_args[i];
+      if (a == "--stride" && i + 1 < g_args.size())
+        g_stride = std::max(1ul, std::stoul(g_args[++i]));
+      else if (a == "--samples" && i + 1 < g_args.size())
+        g_samples = std::stol(g_args[++i]);
+      else if (a == "--threads" && i + 1 < g_args.size())
+        g_threads = std::stoul(g_args[++i]);
+      else if (!a.starts_with('-'))
+        names.push_back(a);
+    }
+
+  std::cout << "    name    type   N   policy     max ULP    mean ULP  mismatches"
+               "     samples  cycles/val   (worst input)\n";
+  std::apply([&](const auto&... fun) {
+    ([&] {
+      constexpr int arity = std::remove_cvref_t<decltype(fun)>::arity;
+      if (names.empty() || std::ranges::find(names, fun.name) != names.end())
+        {
+          report<float, arity>(fun);
+          report<double, arity>(fun);
+        }
+    }(), ...);
+  }, functions);
+}
+
+// vim: et ts=8 sw=2 tw=100
@@ -0,0 +1,183 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef _GLIBCXX_SIMD_ALLOCATOR_H
+#define _GLIBCXX_SIMD_ALLOCATOR_H 1
+
+#ifdef _GLIBCXX_SYSHDR
+#pragma GCC system_header
+#endif
+
+#if __cplusplus >= 202400L
+
+#include "simd_loadstore.h"
+
+#include <memory>
+#include <new>
+#include <vector>
+
+// opt-in: <sys/mman.h> declares many non-reserved names
+#if VIR_HUGE_PAGES && __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+// psabi warnings are bogus because the ABI of the internal types never leaks into user code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#if VIR_EXTENSIONS
+// Padded and aligned allocation (extension) ----------------------------------
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace simd
+{
+  /** @internal
+   * Default alignment and padding granularity of aligned_allocator: the size of the widest native
+   * vec (AVX-512), which is also the cache line size. This does not depend on the target flags, so
+   * that all TUs agree on the type.
+   */
+  inline constexpr size_t __padded_alignment = 64;
+
+  /** @internal
+   * Allocations of at least this many bytes are backed by transparent huge pages if requested.
+   */
+  inline constexpr size_t __huge_page_size = size_t(2) << 20;
+
+  /** @brief Allocator that aligns to @p _Align bytes and rounds every allocation up to a multiple
+   * of @p _Align bytes (at least __padded_alignment).
+   *
+   * Thus, the memory of a complete vec (up to max(_Align, 64) bytes) starting at any element with
+   * an index that is a multiple of the vec size is allocated. Loops over containers using this
+   * allocator therefore need no partial loads and stores for the tail (see __flag_padded). The
+   * contents of the padding are unspecified.
+   *
+   * If @p _HugePages is true, allocations of at least 2 MiB are aligned to 2 MiB, which reduces TLB
+   * misses when streaming over large arrays if the kernel backs them by transparent huge pages.
+   * With VIR_HUGE_PAGES defined, they are additionally advised to be backed by transparent huge
+   * pages (madvise(MADV_HUGEPAGE)), which is needed unless THP is enabled for all mappings.
+   */
+  template <typename _Tp, size_t _Align = __padded_alignment, bool _HugePages = false>
+    class aligned_allocator
+    {
+      static_assert(__has_single_bit(_Align) && _Align >= alignof(_Tp),
+		    "the alignment must be a power of 2 and at least alignof(T)");
+
+    public:
+      using value_type = _Tp;
+
+      using size_type = size_t;
+
+      using difference_type = ptrdiff_t;
+
+      using propagate_on_container_move_assignment = true_type;
+
+      using is_always_equal = true_type;
+
+      template <typename _Up>
+	struct rebind
+	{
+	  static_assert(_Align >= alignof(_Up),
+			"cannot rebind aligned_allocator to a type with larger alignment");
+
+	  using other = aligned_allocator<_Up, _Align, _HugePages>;
+	};
+
+      /** @internal
+       * Allocations are padded to a multiple of this many bytes.
+       */
+      static constexpr size_t _S_granule = std::max(_Align, __padded_alignment);
+
+      constexpr
+      aligned_allocator() noexcept = default;
+
+      template <typename _Up, size_t _A2>
+	constexpr
+	aligned_allocator(const aligned_allocator<_Up, _A2, _HugePages>&) noexcept
+	{}
+
+      [[nodiscard]] constexpr _Tp*
+      allocate(size_t __n)
+      {
+	if (__n > (numeric_limits<size_t>::max() - __huge_page_size) / sizeof(_Tp))
+	  __throw_bad_array_new_length();
+	if consteval
+	  {
+	    return allocator<_Tp>().allocate(_S_padded_bytes(__n) / sizeof(_Tp));
+	  }
+	const size_t __bytes = _S_padded_bytes(__n);
+	void* __p = ::operator new(__bytes, align_val_t(_S_alignment(__bytes)));
+#if VIR_HUGE_PAGES && defined MADV_HUGEPAGE
+	if (_HugePages && __bytes >= __huge_page_size)
+	  ::madvise(__p, __bytes, MADV_HUGEPAGE); // only a hint, ignore failure
+#endif
+	return static_cast<_Tp*>(__p);
+      }
+
+      constexpr void
+      deallocate(_Tp* __p, size_t __n) noexcept
+      {
+	if consteval
+	  {
+	    allocator<_Tp>().deallocate(__p, _S_padded_bytes(__n) / sizeof(_Tp));
+	    return;
+	  }
+	const size_t __bytes = _S_padded_bytes(__n);
+	::operator delete(__p, __bytes, align_val_t(_S_alignment(__bytes)));
+      }
+
+      template <typename _Up, size_t _A2>
+	friend constexpr bool
+	operator==(const aligned_allocator&,
+		   const aligned_allocator<_Up, _A2, _HugePages>&) noexcept
+	{ return true; }
+
+    private:
+      /** @internal
+       * Returns the allocation size in bytes for @p __n elements. It is a multiple of both the
+       * granule and sizeof(_Tp).
+       */
+      static constexpr size_t
+      _S_padded_bytes(size_t __n)
+      {
+	const size_t __bytes = (__n * sizeof(_Tp) + _S_granule - 1) / _S_granule * _S_granule;
+	const size_t __padded = __div_ceil(__bytes, sizeof(_Tp)) * sizeof(_Tp);
+	if (_HugePages && __padded >= __huge_page_size)
+	  return (__padded + __huge_page_size - 1) / __huge_page_size * __huge_page_size;
+	else
+	  return __padded;
+      }
+
+      static constexpr size_t
+      _S_alignment(size_t __bytes)
+      {
+	if (_HugePages && __bytes >= __huge_page_size)
+	  return std::max(_Align, __huge_page_size);
+	else
+	  return _Align;
+      }
+    };
+
+  /** @brief A vector whose storage is aligned for flag_aligned and padded with aligned_allocator.
+   *
+   * Partial loads and stores from / to a padded_vector (passed as the range argument, not as
+   * iterators) load / store complete vecs. Range algorithms (e.g. the BLAS kernels) do the same
+   * for their tails.
+   */
+  template <typename _Tp, size_t _Align = __padded_alignment>
+    using padded_vector = vector<_Tp, aligned_allocator<_Tp, _Align>>;
+
+  template <typename _Tp, size_t _Align, bool _HugePages>
+    requires is_trivially_copyable_v<_Tp>
+    constexpr size_t __padded_range_bytes<vector<_Tp, aligned_allocator<_Tp, _Align, _HugePages>>>
+      = aligned_allocator<_Tp, _Align, _HugePages>::_S_granule;
+} // namespace simd
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+#endif // VIR_EXTENSIONS
+
+#pragma GCC diagnostic pop
+#endif // C++26
+#endif // _GLIBCXX_SIMD_ALLOCATOR_H
@@ -0,0 +1,593 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2025–2026 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef _GLIBCXX_SIMD_BLAS_H
+#define _GLIBCXX_SIMD_BLAS_H 1
+
+#ifdef _GLIBCXX_SYSHDR
+#pragma GCC system_header
+#endif
+
+#if __cplusplus >= 202400L
+
+#include "simd_complex.h"
+#include "simd_loadstore.h"
+#include "simd_math.h"
+#include "simd_reductions.h"
+
+#include <complex>
+
+// psabi warnings are bogus because the ABI of the internal types never leaks into user code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#if VIR_EXTENSIONS
+// BLAS level 1 kernels over complex ranges (extension) ----------------------
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace simd
+{
+  /** @internal
+   * Number of independent accumulators used in the reductions below. Four hide the latency of a
+   * (complex) FMA on current x86 cores without running out of registers for vec<complex<double>>
+   * with AVX-512.
+   */
+  inline constexpr int __blas_accumulators = 4;
+
+  /** @internal
+   * A contiguous range of (interleaved) complex values.
+   */
+  template <typename _Rg>
+    concept __complex_range
+      = __sized_contiguous_range<_Rg> && __complex_like<ranges::range_value_t<_Rg>>;
+
+  /** @internal
+   * A contiguous range of real values, e.g. the real or imaginary part of a split complex array.
+   */
+  template <typename _Rg>
+    concept __real_range
+      = __sized_contiguous_range<_Rg> && is_floating_point_v<ranges::range_value_t<_Rg>>;
+
+  template <typename _R0, typename... _Rs>
+    concept __same_value_type_ranges
+      = (same_as<ranges::range_value_t<_R0>, ranges::range_value_t<_Rs>> && ...);
+
+  /** @internal
+   * @brief Precondition check shared by all kernels: all ranges have the same number of elements.
+   *
+   * @return The common size.
+   */
+  template <typename _R0, typename... _Rs>
+    [[__gnu__::__always_inline__]]
+    constexpr size_t
+    __blas_common_size(const _R0& __r0, const _Rs&... __rs)
+    {
+      const size_t __n = ranges::size(__r0);
+      __glibcxx_simd_precondition(((ranges::size(__rs) == __n) && ...),
+				  "all ranges must have the same size");
+      return __n;
+    }
+
+  /** @internal
+   * Returns __flag_padded if the tails of all ranges @p _Rgs may be accessed with complete @p _Vp
+   * (see padded_vector), flags<>() otherwise.
+   */
+  template <typename _Vp, typename... _Rgs>
+    consteval auto
+    __blas_tail_flags()
+    {
+      if constexpr ((__padded_access<_Vp, _Rgs> && ...))
+	return __flag_padded;
+      else
+	return flags<>();
+    }
+
+  /** @internal
+   * @brief Complex dot product of interleaved arrays: sum of (conj(x[i]) if _Conj) * y[i].
+   */
+  template <bool _Conj, typename _Cx, typename... _Flags>
+    constexpr _Cx
+    __cx_dot(const _Cx* __x, const _Cx* __y, size_t __n, flags<_Flags...> __f = {})
+    {
+      using _Vp = vec<_Cx>;
+      constexpr size_t __w = _Vp::size();
+      constexpr size_t __step = __w * __blas_accumulators;
+      const auto __xv = [&] [[__gnu__::__always_inline__]] (_Vp __v) {
+	if constexpr (_Conj)
+	  return conj(__v);
+	else
+	  return __v;
+      };
+      _Vp __acc[__blas_accumulators] = {};
+      size_t __i = 0;
+      for (; __i + __step <= __n; __i += __step)
+	template for (constexpr int __j : _IotaArray<__blas_accumulators>)
+	  __acc[__j] = fma(__xv(unchecked_load<_Vp>(__x + __i + __j * __w, __w)),
+			   unchecked_load<_Vp>(__y + __i + __j * __w, __w), __acc[__j]);
+      for (; __i + __w <= __n; __i += __w)
+	__acc[0] = fma(__xv(unchecked_load<_Vp>(__x + __i, __w)),
+		       unchecked_load<_Vp>(__y + __i, __w), __acc[0]);
+      if (__i < __n)
+	__acc[1] = fma(__xv(partial_load<_Vp>(__x + __i, __n - __i, __f)),
+		       partial_load<_Vp>(__y + __i, __n - __i, __f), __acc[1]);
+      return reduce((__acc[0] + __acc[1]) + (__acc[2] + __acc[3]));
+    }
+
+  /** @internal
+   * @brief Complex dot product of split (real, imag) arrays.
+   */
+  template <bool _Conj, typename _Tp, typename... _Flags>
+    constexpr complex<_Tp>
+    __split_dot(const _Tp* __xre, const _Tp* __xim, const _Tp* __yre, const _Tp* __yim,
+		size_t __n, flags<_Flags...> __f = {})
+    {
+      using _Vp = vec<_Tp>;
+      constexpr size_t __w = _Vp::size();
+      constexpr int __nacc = __blas_accumulators / 2; // real and imag need one each
+      constexpr size_t __step = __w * __nacc;
+      _Vp __re[__nacc] = {};
+      _Vp __im[__nacc] = {};
+      const auto __accumulate = [&] [[__gnu__::__always_inline__]] (
+				  int __j, _Vp __xr, _Vp __xi, _Vp __yr, _Vp __yi) {
+	if constexpr (_Conj)
+	  __xi = -__xi;
+	__re[__j] += __xr * __yr - __xi * __yi;
+	__im[__j] += __xr * __yi + __xi * __yr;
+      };
+      size_t __i = 0;
+      for (; __i + __step <= __n; __i += __step)
+	template for (constexpr int __j : _IotaArray<__nacc>)
+	  {
+	    const size_t __k = __i + __j * __w;
+	    __accumulate(__j, unchecked_load<_Vp>(__xre + __k, __w),
+			 unchecked_load<_Vp>(__xim + __k, __w),
+			 unchecked_load<_Vp>(__yre + __k, __w),
+			 unchecked_load<_Vp>(__yim + __k, __w));
+	  }
+      for (; __i + __w <= __n; __i += __w)
+	__accumulate(0, unchecked_load<_Vp>(__xre + __i, __w), unchecked_load<_Vp>(__xim + __i, __w),
+		     unchecked_load<_Vp>(__yre + __i, __w), unchecked_load<_Vp>(__yim + __i, __w));
+      if (__i < __n)
+	{
+	  const size_t __r = __n - __i;
+	  __accumulate(1, partial_load<_Vp>(__xre + __i, __r, __f),
+		       partial_load<_Vp>(__xim + __i, __r, __f),
+		       partial_load<_Vp>(__yre + __i, __r, __f),
+		       partial_load<_Vp>(__yim + __i, __r, __f));
+	}
+      return complex<_Tp>(reduce(__re[0] + __re[1]), reduce(__im[0] + __im[1]));
+    }
+
+  /** @internal
+   * @brief y[i] = alpha * x[i] + y[i] (or y[i] = alpha * y[i] if @p __x is nullptr).
+   */
+  template <typename _Cx, typename... _Flags>
+    constexpr void
+    __cx_axpy(const _Cx& __alpha, const _Cx* __x, _Cx* __y, size_t __n,
+	      flags<_Flags...> __f = {})
+    {
+      using _Vp = vec<_Cx>;
+      constexpr size_t __w = _Vp::size();
+      const _Vp __a = __alpha;
+      size_t __i = 0;
+      if (__x == nullptr)
+	{
+	  for (; __i + __w <= __n; __i += __w)
+	    unchecked_store(__a * unchecked_load<_Vp>(__y + __i, __w), __y + __i, __w);
+	  if (__i < __n)
+	    partial_store(__a * partial_load<_Vp>(__y + __i, __n - __i, __f), __y + __i, __n - __i,
+			  __f);
+	}
+      else
+	{
+	  for (; __i + __w <= __n; __i += __w)
+	    unchecked_store(fma(__a, unchecked_load<_Vp>(__x + __i, __w),
+				unchecked_load<_Vp>(__y + __i, __w)), __y + __i, __w);
+	  if (__i < __n)
+	    partial_store(fma(__a, partial_load<_Vp>(__x + __i, __n - __i, __f),
+			      partial_load<_Vp>(__y + __i, __n - __i, __f)), __y + __i, __n - __i,
+			  __f);
+	}
+    }
+
+  /** @internal
+   * @brief Split-array variant of __cx_axpy.
+   */
+  template <typename _Tp, typename... _Flags>
+    constexpr void
+    __split_axpy(const complex<_Tp>& __alpha, const _Tp* __xre, const _Tp* __xim,
+		 _Tp* __yre, _Tp* __yim, size_t __n, flags<_Flags...> __f = {})
+    {
+      using _Vp = vec<_Tp>;
+      constexpr size_t __w = _Vp::size();
+      const _Vp __ar = __alpha.real();
+      const _Vp __ai = __alpha.imag();
+      const auto __step = [&] [[__gnu__::__always_inline__]] (
+			    const _Vp& __xr, const _Vp& __xi, _Vp& __yr, _Vp& __yi) {
+	__yr += __ar * __xr - __ai * __xi;
+	__yi += __ar * __xi + __ai * __xr;
+      };
+      size_t __i = 0;
+      for (; __i + __w <= __n; __i += __w)
+	{
+	  _Vp __yr = unchecked_load<_Vp>(__yre + __i, __w);
+	  _Vp __yi = unchecked_load<_Vp>(__yim + __i, __w);
+	  __step(unchecked_load<_Vp>(__xre + __i, __w), unchecked_load<_Vp>(__xim + __i, __w),
+		 __yr, __yi);
+	  unchecked_store(__yr, __yre + __i, __w);
+	  unchecked_store(__yi, __yim + __i, __w);
+	}
+      if (__i < __n)
+	{
+	  const size_t __r = __n - __i;
+	  _Vp __yr = partial_load<_Vp>(__yre + __i, __r, __f);
+	  _Vp __yi = partial_load<_Vp>(__yim + __i, __r, __f);
+	  __step(partial_load<_Vp>(__xre + __i, __r, __f), partial_load<_Vp>(__xim + __i, __r, __f),
+		 __yr, __yi);
+	  partial_store(__yr, __yre + __i, __r, __f);
+	  partial_store(__yi, __yim + __i, __r, __f);
+	}
+    }
+
+  /** @internal
+   * @brief Split-array variant of scal: (re, im)[i] = alpha * (re, im)[i].
+   */
+  template <typename _Tp, typename... _Flags>
+    constexpr void
+    __split_scal(const complex<_Tp>& __alpha, _Tp* __re, _Tp* __im, size_t __n,
+		 flags<_Flags...> __f = {})
+    {
+      using _Vp = vec<_Tp>;
+      constexpr size_t __w = _Vp::size();
+      const _Vp __ar = __alpha.real();
+      const _Vp __ai = __alpha.imag();
+      size_t __i = 0;
+      for (; __i + __w <= __n; __i += __w)
+	{
+	  const _Vp __r = unchecked_load<_Vp>(__re + __i, __w);
+	  const _Vp __m = unchecked_load<_Vp>(__im + __i, __w);
+	  unchecked_store(__ar * __r - __ai * __m, __re + __i, __w);
+	  unchecked_store(__ar * __m + __ai * __r, __im + __i, __w);
+	}
+      if (__i < __n)
+	{
+	  const size_t __k = __n - __i;
+	  const _Vp __r = partial_load<_Vp>(__re + __i, __k, __f);
+	  const _Vp __m = partial_load<_Vp>(__im + __i, __k, __f);
+	  partial_store(__ar * __r - __ai * __m, __re + __i, __k, __f);
+	  partial_store(__ar * __m + __ai * __r, __im + __i, __k, __f);
+	}
+    }
+
+  consteval int
+  __floor_half(int __x)
+  { return __x >= 0 ? __x / 2 : -((1 - __x) / 2); }
+
+  consteval int
+  __ceil_half(int __x)
+  { return -__floor_half(-__x); }
+
+  template <typename _Tp>
+    consteval _Tp
+    __exp2i(int __e)
+    {
+      _Tp __r = 1;
+      for (; __e > 0; --__e)
+	__r *= 2;
+      for (; __e < 0; ++__e)
+	__r /= 2;
+      return __r;
+    }
+
+  /** @internal
+   * @brief Overflow- and underflow-safe sum of squares (Blue's algorithm).
+   *
+   * Every lane keeps three partial sums for small, medium, and large magnitudes. Small and large
+   * inputs are scaled by a power of two before squaring, which (as the rescaling in
+   * lib/hypot2.cpp) introduces no rounding error. The thresholds follow LAPACK's xNRM2
+   * (Anderson 2017).
+   */
+  template <typename _Vp>
+    struct _SumOfSquares
+    {
+      using _Tp = typename _Vp::value_type;
+
+      using _Lp = numeric_limits<_Tp>;
+
+      static constexpr _Tp _S_tsml = __exp2i<_Tp>(__ceil_half(_Lp::min_exponent - 1));
+
+      static constexpr _Tp _S_tbig = __exp2i<_Tp>(__floor_half(_Lp::max_exponent
+								 - _Lp::digits + 1));
+
+      static constexpr _Tp _S_ssml = __exp2i<_Tp>(-__floor_half(_Lp::min_exponent
+								  - _Lp::digits));
+
+      static constexpr _Tp _S_sbig = __exp2i<_Tp>(-__ceil_half(_Lp::max_exponent
+								 + _Lp::digits - 1));
+
+      _Vp _M_sml = {};
+
+      _Vp _M_med = {};
+
+      _Vp _M_big = {};
+
+      [[__gnu__::__always_inline__]]
+      constexpr void
+      _M_add(const _Vp& __x)
+      {
+	const _Vp __a = __x._M_fabs();
+	const auto __is_big = __a > _Vp(_S_tbig);
+	const auto __is_sml = __a < _Vp(_S_tsml);
+	const _Vp __ab = __a * _S_sbig;
+	const _Vp __as = __a * _S_ssml;
+	_M_big += __select_impl(__is_big, __ab * __ab, _Vp());
+	_M_sml += __select_impl(__is_sml, __as * __as, _Vp());
+	// NaN lands here and propagates to the result
+	_M_med += __select_impl(__is_big || __is_sml, _Vp(), __a * __a);
+      }
+
+      [[__gnu__::__always_inline__]]
+      constexpr _SumOfSquares&
+      operator+=(const _SumOfSquares& __rhs)
+      {
+	_M_sml += __rhs._M_sml;
+	_M_med += __rhs._M_med;
+	_M_big += __rhs._M_big;
+	return *this;
+      }
+
+      /** @internal
+       * @brief Returns the square root of the sum over all lanes.
+       */
+      constexpr _Tp
+      _M_sqrt() const
+      {
+	_Tp __abig = reduce(_M_big);
+	_Tp __amed = reduce(_M_med);
+	_Tp __asml = reduce(_M_sml);
+	_Tp __scl = 1;
+	_Tp __sumsq = __amed;
+	if (__abig > 0)
+	  {
+	    if (__amed > 0 || __amed != __amed)
+	      __abig += (__amed * _S_sbig) * _S_sbig;
+	    __scl = 1 / _S_sbig;
+	    __sumsq = __abig;
+	  }
+	else if (__asml > 0)
+	  {
+	    if (__amed > 0 || __amed != __amed)
+	      {
+		__amed = std::sqrt(__amed);
+		__asml = std::sqrt(__asml) / _S_ssml;
+		const _Tp __ymin = __asml > __amed ? __amed : __asml;
+		const _Tp __ymax = __asml > __amed ? __asml : __amed;
+		const _Tp __q = __ymin / __ymax;
+		__sumsq = __ymax * __ymax * (1 + __q * __q);
+	      }
+	    else
+	      {
+		__scl = 1 / _S_ssml;
+		__sumsq = __asml;
+	      }
+	  }
+	return __scl * std::sqrt(__sumsq);
+      }
+    };
+
+  /** @internal
+   * @brief Euclidean norm of the concatenation of the real arrays @p __ps.
+   *
+   * _Float16 is accumulated in float, where no scaling is necessary.
+   */
+  template <typename _Tp, typename... _Flags, same_as<const _Tp*>... _Ptrs>
+    constexpr _Tp
+    __real_nrm2(flags<_Flags...> __f, size_t __n, _Ptrs... __ps)
+    {
+      using _Vp = vec<_Tp>;
+      constexpr size_t __w = _Vp::size();
+      if constexpr (sizeof(_Tp) < sizeof(float))
+	{
+	  using _Vf = rebind_t<float, _Vp>;
+	  _Vf __acc[2] = {};
+	  size_t __i = 0;
+	  for (; __i + __w <= __n; __i += __w)
+	    {
+	      const _Vf __a[] = {_Vf(unchecked_load<_Vp>(__ps + __i, __w))...};
+	      for (size_t __j = 0; __j < sizeof...(_Ptrs); ++__j)
+		__acc[__j & 1] += __a[__j] * __a[__j];
+	    }
+	  if (__i < __n)
+	    {
+	      const _Vf __a[] = {_Vf(partial_load<_Vp>(__ps + __i, __n - __i, __f))...};
+	      for (size_t __j = 0; __j < sizeof...(_Ptrs); ++__j)
+		__acc[__j & 1] += __a[__j] * __a[__j];
+	    }
+	  return static_cast<_Tp>(std::sqrt(reduce(__acc[0] + __acc[1])));
+	}
+      else
+	{
+	  constexpr size_t __step = __w * 2;
+	  _SumOfSquares<_Vp> __acc[2] = {};
+	  size_t __i = 0;
+	  for (; __i + __step <= __n; __i += __step)
+	    {
+	      (__acc[0]._M_add(unchecked_load<_Vp>(__ps + __i, __w)), ...);
+	      (__acc[1]._M_add(unchecked_load<_Vp>(__ps + __i + __w, __w)), ...);
+	    }
+	  for (; __i + __w <= __n; __i += __w)
+	    (__acc[0]._M_add(unchecked_load<_Vp>(__ps + __i, __w)), ...);
+	  if (__i < __n)
+	    (__acc[1]._M_add(partial_load<_Vp>(__ps + __i, __n - __i, __f)), ...);
+	  __acc[0] += __acc[1];
+	  return __acc[0]._M_sqrt();
+	}
+    }
+
+  // dot ----------------------------------------------------------------------
+  /** @brief Returns the sum of @c x[i] * @c y[i] over interleaved complex arrays.
+   */
+  template <__complex_range _R0, __complex_range _R1>
+    requires __same_value_type_ranges<_R0, _R1>
+    constexpr ranges::range_value_t<_R0>
+    dot(_R0&& __x, _R1&& __y)
+    {
+      return __cx_dot<false>(ranges::data(__x), ranges::data(__y), __blas_common_size(__x, __y),
+			     __blas_tail_flags<vec<ranges::range_value_t<_R0>>, _R0, _R1>());
+    }
+
+  /** @brief Returns the sum of @c x[i] * @c y[i] over split complex arrays.
+   */
+  template <__real_range _R0, __real_range _R1, __real_range _R2, __real_range _R3>
+    requires __same_value_type_ranges<_R0, _R1, _R2, _R3>
+    constexpr complex<ranges::range_value_t<_R0>>
+    dot(_R0&& __xre, _R1&& __xim, _R2&& __yre, _R3&& __yim)
+    {
+      return __split_dot<false>(ranges::data(__xre), ranges::data(__xim), ranges::data(__yre),
+				ranges::data(__yim), __blas_common_size(__xre, __xim, __yre, __yim),
+				__blas_tail_flags<vec<ranges::range_value_t<_R0>>,
+						  _R0, _R1, _R2, _R3>());
+    }
+
+  // dotc ---------------------------------------------------------------------
+  /** @brief Returns the sum of @c conj(x[i]) * @c y[i] over interleaved complex arrays.
+   */
+  template <__complex_range _R0, __complex_range _R1>
+    requires __same_value_type_ranges<_R0, _R1>
+    constexpr ranges::range_value_t<_R0>
+    dotc(_R0&& __x, _R1&& __y)
+    {
+      return __cx_dot<true>(ranges::data(__x), ranges::data(__y), __blas_common_size(__x, __y),
+			    __blas_tail_flags<vec<ranges::range_value_t<_R0>>, _R0, _R1>());
+    }
+
+  /** @brief Returns the sum of @c conj(x[i]) * @c y[i] over split complex arrays.
+   */
+  template <__real_range _R0, __real_range _R1, __real_range _R2, __real_range _R3>
+    requires __same_value_type_ranges<_R0, _R1, _R2, _R3>
+    constexpr complex<ranges::range_value_t<_R0>>
+    dotc(_R0&& __xre, _R1&& __xim, _R2&& __yre, _R3&& __yim)
+    {
+      return __split_dot<true>(ranges::data(__xre), ranges::data(__xim), ranges::data(__yre),
+			       ranges::data(__yim), __blas_common_size(__xre, __xim, __yre, __yim),
+			       __blas_tail_flags<vec<ranges::range_value_t<_R0>>,
+						 _R0, _R1, _R2, _R3>());
+    }
+
+  // axpy ---------------------------------------------------------------------
+  /** @brief Computes @c y[i] = @p __alpha * @c x[i] + @c y[i] over interleaved complex arrays.
+   */
+  template <__complex_range _R0, __complex_range _R1>
+    requires __same_value_type_ranges<_R0, _R1>
+      && indirectly_writable<ranges::iterator_t<_R1>, ranges::range_value_t<_R1>>
+    constexpr void
+    axpy(const ranges::range_value_t<_R0>& __alpha, _R0&& __x, _R1&& __y)
+    {
+      __cx_axpy(__alpha, ranges::data(__x), ranges::data(__y), __blas_common_size(__x, __y),
+		__blas_tail_flags<vec<ranges::range_value_t<_R0>>, _R0, _R1>());
+    }
+
+  /** @brief Computes @c y[i] = @p __alpha * @c x[i] + @c y[i] over split complex arrays.
+   */
+  template <__real_range _R0, __real_range _R1, __real_range _R2, __real_range _R3>
+    requires __same_value_type_ranges<_R0, _R1, _R2, _R3>
+      && indirectly_writable<ranges::iterator_t<_R2>, ranges::range_value_t<_R2>>
+      && indirectly_writable<ranges::iterator_t<_R3>, ranges::range_value_t<_R3>>
+    constexpr void
+    axpy(const complex<ranges::range_value_t<_R0>>& __alpha, _R0&& __xre, _R1&& __xim,
+	 _R2&& __yre, _R3&& __yim)
+    {
+      __split_axpy(__alpha, ranges::data(__xre), ranges::data(__xim), ranges::data(__yre),
+		   ranges::data(__yim), __blas_common_size(__xre, __xim, __yre, __yim),
+		   __blas_tail_flags<vec<ranges::range_value_t<_R0>>, _R0, _R1, _R2, _R3>());
+    }
+
+  // scal ---------------------------------------------------------------------
+  /** @brief Computes @c x[i] = @p __alpha * @c x[i] over an interleaved complex array.
+   */
+  template <__complex_range _Rg>
+    requires indirectly_writable<ranges::iterator_t<_Rg>, ranges::range_value_t<_Rg>>
+    constexpr void
+    scal(const ranges::range_value_t<_Rg>& __alpha, _Rg&& __x)
+    {
+      using _Cx = ranges::range_value_t<_Rg>;
+      __cx_axpy(__alpha, static_cast<const _Cx*>(nullptr), ranges::data(__x), ranges::size(__x),
+		__blas_tail_flags<vec<_Cx>, _Rg>());
+    }
+
+  /** @brief Computes @c x[i] = @p __alpha * @c x[i] over a split complex array.
+   */
+  template <__real_range _R0, __real_range _R1>
+    requires __same_value_type_ranges<_R0, _R1>
+      && indirectly_writable<ranges::iterator_t<_R0>, ranges::range_value_t<_R0>>
+      && indirectly_writable<ranges::iterator_t<_R1>, ranges::range_value_t<_R1>>
+    constexpr void
+    scal(const complex<ranges::range_value_t<_R0>>& __alpha, _R0&& __re, _R1&& __im)
+    {
+      __split_scal(__alpha, ranges::data(__re), ranges::data(__im),
+		   __blas_common_size(__re, __im),
+		   __blas_tail_flags<vec<ranges::range_value_t<_R0>>, _R0, _R1>());
+    }
+
+  // nrm2 ---------------------------------------------------------------------
+  /** @brief Returns the Euclidean norm of an interleaved complex array, without intermediate
+   * overflow or underflow.
+   */
+  template <__complex_range _Rg>
+    constexpr typename ranges::range_value_t<_Rg>::value_type
+    nrm2(_Rg&& __x)
+    {
+      using _Tp = typename ranges::range_value_t<_Rg>::value_type;
+      if consteval
+	{
+	  // reinterpret_cast is not allowed in constant expressions: scaled sum of squares over
+	  // the real and imaginary parts (as in the reference BLAS)
+	  using _Ap = conditional_t<sizeof(_Tp) < sizeof(float), float, _Tp>;
+	  _Ap __scale = 0;
+	  _Ap __ssq = 1;
+	  for (const auto& __z : __x)
+	    for (_Ap __v : {_Ap(__z.real()), _Ap(__z.imag())})
+	      {
+		const _Ap __a = __v < 0 ? -__v : __v;
+		if (__a == 0)
+		  continue;
+		else if (__scale < __a)
+		  {
+		    __ssq = 1 + __ssq * (__scale / __a) * (__scale / __a);
+		    __scale = __a;
+		  }
+		else
+		  __ssq += (__a / __scale) * (__a / __scale);
+	      }
+	  return static_cast<_Tp>(__scale * std::sqrt(__ssq));
+	}
+      // complex<T> is layout-compatible with T[2] ([complex.numbers.general])
+      return __real_nrm2<_Tp>(__blas_tail_flags<vec<_Tp>, _Rg>(), ranges::size(__x) * 2,
+			      reinterpret_cast<const _Tp*>(ranges::data(__x)));
+    }
+
+  /** @brief Returns the Euclidean norm of a split complex array, without intermediate overflow or
+   * underflow.
+   */
+  template <__real_range _R0, __real_range _R1>
+    requires __same_value_type_ranges<_R0, _R1>
+    constexpr ranges::range_value_t<_R0>
+    nrm2(_R0&& __re, _R1&& __im)
+    {
+      using _Tp = ranges::range_value_t<_R0>;
+      const size_t __n = __blas_common_size(__re, __im);
+      return __real_nrm2<_Tp>(__blas_tail_flags<vec<_Tp>, _R0, _R1>(), __n,
+			      static_cast<const _Tp*>(ranges::data(__re)),
+			      static_cast<const _Tp*>(ranges::data(__im)));
+    }
+} // namespace simd
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+#endif // VIR_EXTENSIONS
+
+#pragma GCC diagnostic pop
+#endif // C++26
+#endif // _GLIBCXX_SIMD_BLAS_H
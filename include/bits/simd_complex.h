@@ -14,6 +14,11 @@
 
 #include "simd_vec.h"
 
+#ifndef VIR_PATCH_IMPROVE_CX
+// choose the strategy per value-type, register width, and target (see __improve_cx_strategy)
+#define VIR_PATCH_IMPROVE_CX -1
+#endif
+
 // psabi warnings are bogus because the ABI of the internal types never leaks into user code
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpsabi"
@@ -24,6 +29,41 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 namespace simd
 {
 #if VIR_PATCH_IMPROVE_CX
+  /** @internal
+   * @brief Returns the code-gen strategy of __hadd for a @p _Bytes sized register of @p _Tp.
+   *
+   * 1. Add swapped neighbors, then compress the even elements.
+   * 2. Compress even and odd elements, then add.
+   * 3. x86 haddps/haddpd (uses 1 where there is no such instruction).
+   *
+   * A positive VIR_PATCH_IMPROVE_CX forces the strategy. Otherwise the table below applies.
+   * `make -C benchtests improve-cx-table` measures all strategies per type and width and records
+   * the cycle counts in benchtests/improve_cx_table/<arch>-<cpu>.out; update the table from
+   * these measurements. Entries without a measurement are estimated from the uop counts and
+   * latencies of the instruction sequences.
+   */
+  template <typename _Tp, int _Bytes, _ArchTraits _Traits = {}>
+    consteval int
+    __improve_cx_strategy()
+    {
+#if VIR_PATCH_IMPROVE_CX > 0
+      return VIR_PATCH_IMPROVE_CX;
+#elif _GLIBCXX_X86
+      if constexpr (sizeof(_Tp) == 2)
+	// AVX512FP16: no horizontal add, two vpermw are cheaper than the swap + compress sequence
+	return 2;
+      else if constexpr (!_Traits._M_have_sse3() || _Bytes > 32)
+	return 1;
+      else if constexpr (_Traits._M_tune_zen())
+	// Zen: the 256-bit hadd decodes to more uops than two permutes + add
+	return _Bytes == 16 ? 3 : 2;
+      else
+	return 3;
+#else
+      return 1;
+#endif
+    }
+
   /** @internal
    * @brief Add neighboring elements while shifting element positions down accordingly.
    *
@@ -49,31 +89,35 @@ namespace simd
 	return cat(__hadd(__x._M_get_low(), __x._M_get_high()), __hadd(__y));
       else
 	{
-#if _GLIBCXX_X86 && VIR_PATCH_IMPROVE_CX == 3
-	  if ! consteval
+	  constexpr int __strategy
+	    = __improve_cx_strategy<typename _V0::value_type, sizeof(__x), _Traits>();
+#if _GLIBCXX_X86
+	  if constexpr (__strategy == 3)
 	    {
-	      constexpr bool __is_fp32 = sizeof(typename _V0::value_type) == sizeof(float);
-	      constexpr bool __is_fp64 = sizeof(typename _V0::value_type) == sizeof(double);
-	      if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp32)
-		return __builtin_ia32_haddps(__x._M_get(), __vec_zero_pad_to<16>(__y._M_get()));
-	      else if constexpr (_Traits._M_have_avx() && sizeof(__x) == 32 && __is_fp32)
-		return __x86_swizzle4x64_acbd(
-			 __builtin_ia32_haddps256(__x._M_get(), __vec_zero_pad_to<32>(__y._M_get())));
-	      else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp64)
-		return __builtin_ia32_haddpd(__x._M_get(), __vec_zero_pad_to<16>(__y._M_get()));
-	      else if constexpr (_Traits._M_have_avx() && sizeof(__x) == 32 && __is_fp64)
-		return __x86_swizzle4x64_acbd(
-			 __builtin_ia32_haddpd256(__x._M_get(), __vec_zero_pad_to<32>(__y._M_get())));
+	      if ! consteval
+		{
+		  constexpr bool __is_fp32 = sizeof(typename _V0::value_type) == sizeof(float);
+		  constexpr bool __is_fp64 = sizeof(typename _V0::value_type) == sizeof(double);
+		  if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp32)
+		    return __builtin_ia32_haddps(__x._M_get(), __vec_zero_pad_to<16>(__y._M_get()));
+		  else if constexpr (_Traits._M_have_avx() && sizeof(__x) == 32 && __is_fp32)
+		    return __x86_swizzle4x64_acbd(
+			     __builtin_ia32_haddps256(__x._M_get(), __vec_zero_pad_to<32>(__y._M_get())));
+		  else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp64)
+		    return __builtin_ia32_haddpd(__x._M_get(), __vec_zero_pad_to<16>(__y._M_get()));
+		  else if constexpr (_Traits._M_have_avx() && sizeof(__x) == 32 && __is_fp64)
+		    return __x86_swizzle4x64_acbd(
+			     __builtin_ia32_haddpd256(__x._M_get(), __vec_zero_pad_to<32>(__y._M_get())));
+		}
 	    }
 #endif
-#if 2 == VIR_PATCH_IMPROVE_CX
-	  return cat(permute<_V0::size() / 2>(__x, [](int __i) consteval { return __i * 2; }),
-		     permute<_V1::size() / 2>(__y, [](int __i) consteval { return __i * 2; }))
-		   + cat(permute<_V0::size() / 2>(__x, [](int __i) consteval { return __i * 2 + 1; }),
-			 permute<_V1::size() / 2>(__y, [](int __i) consteval { return __i * 2 + 1; }));
-#else
-	  return cat(__hadd(__x), __hadd(__y));
-#endif
+	  if constexpr (__strategy == 2)
+	    return cat(permute<_V0::size() / 2>(__x, [](int __i) consteval { return __i * 2; }),
+		       permute<_V1::size() / 2>(__y, [](int __i) consteval { return __i * 2; }))
+		     + cat(permute<_V0::size() / 2>(__x, [](int __i) consteval { return __i * 2 + 1; }),
+			   permute<_V1::size() / 2>(__y, [](int __i) consteval { return __i * 2 + 1; }));
+	  else
+	    return cat(__hadd(__x), __hadd(__y));
 	}
     }
 
@@ -88,28 +132,32 @@ namespace simd
 	return __hadd(__x._M_get_low(), __x._M_get_high());
       else
 	{
-#if _GLIBCXX_X86 && VIR_PATCH_IMPROVE_CX == 3
-	  if !consteval
+	  constexpr int __strategy
+	    = __improve_cx_strategy<typename _Vp::value_type, sizeof(__x), _Traits>();
+#if _GLIBCXX_X86
+	  if constexpr (__strategy == 3)
 	    {
-	      constexpr bool __is_fp32 = sizeof(typename _Vp::value_type) == sizeof(float);
-	      constexpr bool __is_fp64 = sizeof(typename _Vp::value_type) == sizeof(double);
-	      if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp32)
-		return __vec_split_lo(__builtin_ia32_haddps(__x._M_get(), __x._M_get()));
-	      else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 32 && __is_fp32)
-		return __builtin_ia32_haddps(__vec_split_lo(__x._M_get()), __vec_split_hi(__x._M_get()));
-	      else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp64)
-		return __vec_split_lo(__builtin_ia32_haddpd(__x._M_get(), __x._M_get()));
-	      else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 32 && __is_fp64)
-		return __builtin_ia32_haddpd(__vec_split_lo(__x._M_get()), __vec_split_hi(__x._M_get()));
+	      if !consteval
+		{
+		  constexpr bool __is_fp32 = sizeof(typename _Vp::value_type) == sizeof(float);
+		  constexpr bool __is_fp64 = sizeof(typename _Vp::value_type) == sizeof(double);
+		  if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp32)
+		    return __vec_split_lo(__builtin_ia32_haddps(__x._M_get(), __x._M_get()));
+		  else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 32 && __is_fp32)
+		    return __builtin_ia32_haddps(__vec_split_lo(__x._M_get()), __vec_split_hi(__x._M_get()));
+		  else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 16 && __is_fp64)
+		    return __vec_split_lo(__builtin_ia32_haddpd(__x._M_get(), __x._M_get()));
+		  else if constexpr (_Traits._M_have_sse3() && sizeof(__x) == 32 && __is_fp64)
+		    return __builtin_ia32_haddpd(__vec_split_lo(__x._M_get()), __vec_split_hi(__x._M_get()));
+		}
 	    }
 #endif
-#if 2 == VIR_PATCH_IMPROVE_CX
-	  return _V2::_S_static_permute(__x, [](int __i) consteval { return __i * 2; })
-		   + _V2::_S_static_permute(__x, [](int __i) consteval { return __i * 2 + 1; });
-#else
-	  return _V2::_S_static_permute(__x + _Vp::_S_static_permute(__x, _SwapNeighbors<1>()),
-					[](int __i) consteval { return __i * 2; });
-#endif
+	  if constexpr (__strategy == 2)
+	    return _V2::_S_static_permute(__x, [](int __i) consteval { return __i * 2; })
+		     + _V2::_S_static_permute(__x, [](int __i) consteval { return __i * 2 + 1; });
+	  else
+	    return _V2::_S_static_permute(__x + _Vp::_S_static_permute(__x, _SwapNeighbors<1>()),
+					  [](int __i) consteval { return __i * 2; });
 	}
     }
 
@@ -293,6 +341,48 @@ namespace simd
 	  }
       }
 
+    /** @internal
+     * @brief Return the interleaved (ririri...) vector _TV of @p __re and @p __im.
+     *
+     * This is a single two-input shuffle per register, whereas __set_real and __set_imag need to
+     * shuffle and blend twice into an existing vector.
+     */
+    template <typename _TV, typename _RV>
+      [[__gnu__::__always_inline__]]
+      constexpr _TV
+      __interleave(const _RV& __re, const _RV& __im) noexcept
+      {
+	using _Tp = typename _TV::value_type;
+	using _Ap = typename _TV::abi_type;
+	static_assert(_TV::_S_size == 2 * _RV::_S_size);
+	if constexpr (__scalar_abi_tag<_Ap>)
+	  {
+	    _TV __r;
+	    __set_real(__r, __re);
+	    __set_imag(__r, __im);
+	    return __r;
+	  }
+	else if constexpr (_Ap::_S_nreg >= 2)
+	  { // recurse
+	    using _Lo = remove_cvref_t<decltype(declval<const _TV&>()._M_get_low())>;
+	    using _Hi = remove_cvref_t<decltype(declval<const _TV&>()._M_get_high())>;
+	    using _RV0 = __similar_vec<_Tp, _Lo::_S_size / 2, _Ap>;
+	    const auto& [__re0, __re1] = __re.template _M_chunk<_RV0>();
+	    const auto& [__im0, __im1] = __im.template _M_chunk<_RV0>();
+	    return _TV::_S_init(__interleave<_Lo>(__re0, __im0), __interleave<_Hi>(__re1, __im1));
+	  }
+	else
+	  {
+	    using _DataType = typename _Ap::template _DataType<_Tp>;
+	    constexpr int __rw = __width_of<decltype(__re._M_get())>;
+	    constexpr auto [...__is] = _IotaArray<__width_of<_DataType>>;
+	    return _TV::_S_init(_DataType(__builtin_shufflevector(
+					    __re._M_get(), __im._M_get(),
+					    (__is < _TV::_S_size ? (__is & 1) * __rw + __is / 2
+								 : -1)...)));
+	  }
+      }
+
     /** @internal
      * @brief Return @p __x after flipping the sign of odd (imaginary) elements.
      */
@@ -435,6 +525,61 @@ namespace simd
 	      }
 	  }
       }
+
+    /** @internal
+     * @brief Complex multiply-add of @p __x, @p __y, and @p __z, returning the result in @p __x.
+     *
+     * On x86 with FMA the addition is fused into the multiplication (vfmaddcph for
+     * complex<_Float16> with AVX512FP16). Annex G NaN recovery falls back to the unfused
+     * operation.
+     */
+    template <typename _Cx, _TargetTraits _Traits, typename _Tp, typename _Ap>
+      [[__gnu__::__always_inline__]]
+      constexpr void
+      __fma(basic_vec<_Tp, _Ap>& __x, const basic_vec<_Tp, _Ap>& __y,
+	    const basic_vec<_Tp, _Ap>& __z)
+      {
+	static_assert(__complex_like<_Cx>);
+	if constexpr (__scalar_abi_tag<_Ap> && _Ap::_S_size == 2)
+	  {
+	    __mul<_Cx, _Traits>(__x, __y);
+	    __x += __z;
+	  }
+	else if constexpr (_Ap::_S_nreg >= 2)
+	  { // recurse
+	    __fma<_Cx, _Traits>(__x._M_get_low(), __y._M_get_low(), __z._M_get_low());
+	    __fma<_Cx, _Traits>(__x._M_get_high(), __y._M_get_high(), __z._M_get_high());
+	  }
+#if _GLIBCXX_X86
+	else if constexpr (_Traits._M_have_fma())
+	  {
+	    const auto __xv = __x._M_get();
+	    const auto __yv = __y._M_get();
+	    const auto __zv = __z._M_get();
+	    if (__is_const_known(__xv, __yv, __zv))
+	      {
+		__mul<_Cx, _Traits>(__x, __y);
+		__x += __z;
+	      }
+	    else
+	      {
+		__x = __x86_complex_fma(__xv, __yv, __zv);
+		if (_Traits._M_conforming_to_STDC_annex_G() && __x._M_isnan()._M_any_of())
+		  [[unlikely]]
+		  {
+		    basic_vec<_Tp, _Ap> __r = basic_vec<_Tp, _Ap>::_S_init(__xv);
+		    __mul<_Cx, _Traits>(__r, __y);
+		    __x = __r + __z;
+		  }
+	      }
+	  }
+#endif
+	else
+	  {
+	    __mul<_Cx, _Traits>(__x, __y);
+	    __x += __z;
+	  }
+      }
   }
 
   template <size_t _Bytes, __abi_tag _Ap>
@@ -606,9 +751,14 @@ namespace simd
 		// unwrap _CxCtgus mask and recurse
 		return basic_mask(__x._M_data)._M_data;
 
-	      else if constexpr (_UV::_S_is_scalar || _S_is_scalar)
+	      else if constexpr (_S_is_scalar || (_UV::_S_is_scalar && _S_size > 32))
 		// need to duplicate & convert one vector element into two bools
-		return _DataType([&](int __i) { return __x[__i / 2]; }); // TODO: optimize
+		return _DataType([&](int __i) { return __x[__i / 2]; });
+
+	      else if constexpr (_UV::_S_is_scalar)
+		// collect the bools into an integer, duplicate each bit, and let the uint ctor
+		// broadcast + compare into the vector-mask
+		return _DataType(__duplicate_each_bit<_S_size>(__x._M_to_uint()));
 
 	      else if constexpr (_Bytes == _UBytes)
 		return _DataType::_S_recursive_bit_cast(__x);
@@ -1230,10 +1380,8 @@ namespace simd
       [[__gnu__::__always_inline__]]
       constexpr
       basic_vec(const _RealSimd& __re, const _RealSimd& __im = {}) noexcept
-      {
-	__cxileav::__set_real(_M_data, __re);
-	__cxileav::__set_imag(_M_data, __im);
-      }
+      : _M_data(__cxileav::__interleave<_TSimd>(__re, __im))
+      {}
 
       // [simd.subscr] --------------------------------------------------------
       [[__gnu__::__always_inline__]]
@@ -1397,6 +1545,16 @@ namespace simd
 	  return __x;
 	}
 
+      template <_TargetTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_fma(const basic_vec& __x, const basic_vec& __y, const basic_vec& __z) noexcept
+	{
+	  basic_vec __r = __x;
+	  __cxileav::__fma<value_type, _Traits>(__r._M_data, __y._M_data, __z._M_data);
+	  return __r;
+	}
+
 #if VIR_PATCH_IMPROVE_CX
       template <_TargetTraits _Traits = {}>
 	[[__gnu__::__always_inline__]]
@@ -1604,8 +1762,32 @@ namespace simd
 	  }
 	else
 	  {
-	    basic_vec<_Tp, _Ap> __re = __re0 * __re1 - __im0 * __im1;
-	    basic_vec<_Tp, _Ap> __im = __re0 * __im1 + __im0 * __re1;
+	    basic_vec<_Tp, _Ap> __re;
+	    basic_vec<_Tp, _Ap> __im;
+#if _GLIBCXX_X86
+	    if constexpr (_Traits._M_have_avx512fp16() && is_same_v<_Tp, _Float16>)
+	      { // plain FP16 FMAs, no round-trip via float
+		const auto __r0 = __re0._M_get();
+		const auto __i0 = __im0._M_get();
+		const auto __r1 = __re1._M_get();
+		const auto __i1 = __im1._M_get();
+		if (__is_const_known(__r0, __i0, __r1, __i1))
+		  {
+		    __re = __re0 * __re1 - __im0 * __im1;
+		    __im = __re0 * __im1 + __im0 * __re1;
+		  }
+		else
+		  {
+		    __re._M_get() = __x86_fma_ph<true>(__r0, __r1, __i0 * __i1);
+		    __im._M_get() = __x86_fma_ph(__r0, __i1, __i0 * __r1);
+		  }
+	      }
+	    else
+#endif
+	      {
+		__re = __re0 * __re1 - __im0 * __im1;
+		__im = __re0 * __im1 + __im0 * __re1;
+	      }
 	    const auto __nan = __re._M_isunordered(__im);
 	    if (__nan._M_any_of()) [[unlikely]]
 	      __redo_mul<_Cx, _Traits>(__re._M_get(), __im._M_get(), __re0._M_get(), __im0._M_get(),
@@ -1615,6 +1797,72 @@ namespace simd
 	    __im0 = __im;
 	  }
       }
+
+    /** @internal
+     * @brief Complex multiply-add of (@p __re0, @p __im0), (@p __re1, @p __im1), and (@p __re2,
+     * @p __im2), returning the result in @p __re0 and @p __im0.
+     */
+    template <typename _Cx, _TargetTraits _Traits, typename _Tp, typename _Ap>
+      [[__gnu__::__always_inline__]]
+      constexpr void
+      __fma(basic_vec<_Tp, _Ap>& __re0, basic_vec<_Tp, _Ap>& __im0,
+	    const basic_vec<_Tp, _Ap>& __re1, const basic_vec<_Tp, _Ap>& __im1,
+	    const basic_vec<_Tp, _Ap>& __re2, const basic_vec<_Tp, _Ap>& __im2)
+      {
+	static_assert(__complex_like<_Cx>);
+	if constexpr (_Ap::_S_nreg >= 2)
+	  {
+	    __fma<_Cx, _Traits>(__re0._M_get_low(), __im0._M_get_low(),
+				__re1._M_get_low(), __im1._M_get_low(),
+				__re2._M_get_low(), __im2._M_get_low());
+	    __fma<_Cx, _Traits>(__re0._M_get_high(), __im0._M_get_high(),
+				__re1._M_get_high(), __im1._M_get_high(),
+				__re2._M_get_high(), __im2._M_get_high());
+	  }
+#if _GLIBCXX_X86
+	else if constexpr (_Ap::_S_size > 1 && _Traits._M_have_avx512fp16()
+			     && is_same_v<_Tp, _Float16>)
+	  {
+	    const auto __r0 = __re0._M_get();
+	    const auto __i0 = __im0._M_get();
+	    const auto __r1 = __re1._M_get();
+	    const auto __i1 = __im1._M_get();
+	    if (__is_const_known(__r0, __i0, __r1, __i1, __re2._M_get(), __im2._M_get()))
+	      {
+		__mul<_Cx, _Traits>(__re0, __im0, __re1, __im1);
+		__re0 += __re2;
+		__im0 += __im2;
+	      }
+	    else
+	      {
+		// re: r0 * r1 - (i0 * i1 - re2)
+		// im: r0 * i1 + (i0 * r1 + im2)
+		basic_vec<_Tp, _Ap> __re, __im;
+		__re._M_get() = __x86_fma_ph<true>(__r0, __r1,
+						   __x86_fma_ph<true>(__i0, __i1, __re2._M_get()));
+		__im._M_get() = __x86_fma_ph(__r0, __i1, __x86_fma_ph(__i0, __r1, __im2._M_get()));
+		if (_Traits._M_conforming_to_STDC_annex_G() && __re._M_isunordered(__im)._M_any_of())
+		  [[unlikely]]
+		  {
+		    __mul<_Cx, _Traits>(__re0, __im0, __re1, __im1);
+		    __re0 += __re2;
+		    __im0 += __im2;
+		  }
+		else
+		  {
+		    __re0 = __re;
+		    __im0 = __im;
+		  }
+	      }
+	  }
+#endif
+	else
+	  {
+	    __mul<_Cx, _Traits>(__re0, __im0, __re1, __im1);
+	    __re0 += __re2;
+	    __im0 += __im2;
+	  }
+      }
   }
 
   template <size_t _Bytes, __abi_tag _Ap>
@@ -2519,6 +2767,17 @@ namespace simd
 	  return __x;
 	}
 
+      template <_TargetTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_fma(const basic_vec& __x, const basic_vec& __y, const basic_vec& __z) noexcept
+	{
+	  basic_vec __r = __x;
+	  __cxctgus::__fma<value_type, _Traits>(__r._M_real, __r._M_imag, __y._M_real, __y._M_imag,
+						__z._M_real, __z._M_imag);
+	  return __r;
+	}
+
       [[__gnu__::__always_inline__]]
       friend constexpr basic_vec&
       operator/=(basic_vec& __x, const basic_vec& __y) noexcept
@@ -2627,6 +2886,65 @@ namespace simd
       { return basic_vec(_M_real, -_M_imag); }
     };
 
+#if VIR_EXTENSIONS
+  // complex layout deduction (extension) -------------------------------------
+  /** @brief Workload hint for the ABI deduction of complex_vec.
+   */
+  enum class complex_workload
+  {
+    /// Mostly loads, stores, and additions: keep the interleaved (ririri...) memory layout.
+    load_store,
+    /// Mostly multiplication, division, abs, and norm: split reals and imaginaries (rrr... iii...).
+    arithmetic
+  };
+
+  /** @internal
+   * @brief Returns _CxIleav or _CxCtgus ABI tag for @p _Np elements of complex type @p _Tp.
+   *
+   * _CxCtgus needs no shuffles for arithmetic, but needs (de)interleaving on every load and store.
+   * _CxIleav is chosen unconditionally if the target has native complex multiplication for @p _Tp.
+   */
+  template <typename _Tp, int _Np, complex_workload _Wl, _ArchTraits _Traits = {}>
+    consteval auto
+    __deduce_cx_abi()
+    {
+      using _Ileav = __deduce_abi_t<_Tp, _Np>;
+      using _Real = typename _Tp::value_type;
+      using _RNative = __native_abi_t<_Real>;
+      if constexpr (_Wl == complex_workload::load_store || _RNative::_S_size == 1
+		      || __scalar_abi_tag<_Ileav>)
+	return _Ileav();
+      else if constexpr (is_same_v<_Real, _Float16> && _Traits._M_have_avx512fp16())
+	// vfmulcph and vfmaddcph make interleaved multiplication as cheap as split
+	return _Ileav();
+      else
+	return __abi_rebind<_Tp, _Np, _Abi_t<_RNative::_S_size, 1, _AbiVariant::_CxCtgus,
+					     _RNative::_S_variant>>();
+    }
+
+  /** @brief A complex basic_vec with the layout that suits workload @p _Wl on the target.
+   *
+   * Conversions between complex_vec types of different workload are implicit and compile to
+   * shuffles (no memory round-trip).
+   */
+  template <__complex_like _Tp, complex_workload _Wl, int _Np = __native_abi_t<_Tp>::_S_size>
+    using complex_vec = basic_vec<_Tp, decltype(__deduce_cx_abi<_Tp, _Np, _Wl>())>;
+
+#endif
+#if VIR_EXTENSIONS
+  // [simd.complex.math] fma (extension) --------------------------------------
+  /** @brief Returns @p __x * @p __y + @p __z.
+   *
+   * The addition is fused into the complex multiplication where the target supports it.
+   */
+  template <_TargetTraits _Traits = {}, __complex_like _Tp, typename _Ap>
+    [[__gnu__::__always_inline__]]
+    constexpr basic_vec<_Tp, _Ap>
+    fma(const basic_vec<_Tp, _Ap>& __x, const basic_vec<_Tp, _Ap>& __y,
+	const basic_vec<_Tp, _Ap>& __z) noexcept
+    { return basic_vec<_Tp, _Ap>::template _S_fma<_Traits>(__x, __y, __z); }
+
+#endif
   // [P3319R5] (extension) ----------------------------------------------------
   template <__complex_like _Tp, typename _Ap>
     inline constexpr basic_vec<_Tp, _Ap>
@@ -590,6 +590,23 @@ namespace simd
     _M_fast_math() const
     { return _M_test(1); }
 
+    // maximum error of math functions in ULP, as requested via math_precision; 0 if unspecified
+    consteval int
+    _M_max_ulp() const
+    { return (_M_build_flags >> 16) & 0xff; }
+
+    // true iff a kernel with at most @p __ulp ULP error (and conforming inf/NaN handling) meets
+    // the requested precision; without math_precision that is 1 ULP (any with -ffast-math)
+    consteval bool
+    _M_allows_ulp(int __ulp) const
+    { return _M_max_ulp() == 0 ? __ulp <= 1 || _M_fast_math() : _M_max_ulp() >= __ulp; }
+
+    // true iff math functions may call the approximating (__fast_*) kernels, which (like
+    // -ffast-math) assume finite values; never for math_precision
+    consteval bool
+    _M_approx_math() const
+    { return _M_max_ulp() == 0 && _M_fast_math(); }
+
     consteval bool
     _M_finite_math_only() const
     { return _M_test(2); }
@@ -668,6 +685,7 @@ namespace simd
 #if __SUPPORT_SNAN__
 	  + (1 << 11)
 #endif
+	// bits 16 to 23 reserved for the ULP budget of math_precision
 	;
   };
 
@@ -764,6 +782,12 @@ namespace simd
 
 #elif _GLIBCXX_X86
 
+// -mtune (implied by -march) for an AMD Zen core
+#if defined __tune_znver1__ || defined __tune_znver2__ || defined __tune_znver3__ \
+  || defined __tune_znver4__ || defined __tune_znver5__
+#define _GLIBCXX_SIMD_TUNE_ZEN 1
+#endif
+
 #define _GLIBCXX_SIMD_ARCH_TRAITS_INIT {                      \
   _GLIBCXX_SIMD_ARCH_FLAG(0, __MMX__)                         \
     | _GLIBCXX_SIMD_ARCH_FLAG( 1, __SSE__)                    \
@@ -804,6 +828,7 @@ namespace simd
     | _GLIBCXX_SIMD_ARCH_FLAG(36, __SSE4A__)                  \
     | _GLIBCXX_SIMD_ARCH_FLAG(37, __FMA4__)                   \
     | _GLIBCXX_SIMD_ARCH_FLAG(38, __XOP__)                    \
+    | _GLIBCXX_SIMD_ARCH_FLAG(39, _GLIBCXX_SIMD_TUNE_ZEN)     \
   }
   // Should this include __APX_F__? I don't think it's relevant for use in constexpr-if branches =>
   // no ODR issue? The same could be said about several other flags above that are not checked
@@ -814,26 +839,35 @@ namespace simd
     __UINT64_TYPE__ _M_flags = _GLIBCXX_SIMD_ARCH_TRAITS_INIT;
 
 #if VIR_PATCH_MATH
+    // keep only SSE4.1, AVX, FMA, AVX512F, (AVX512FP16)
+    static constexpr __UINT64_TYPE__ _S_math_abi_v1  = 0b0000000000'0000000110; // SSE2
+    static constexpr __UINT64_TYPE__ _S_math_abi_v2  = 0b0000000000'0000111110; // SSE4.1
+    static constexpr __UINT64_TYPE__ _S_math_abi_v3a = 0b0000000000'0111111110; // AVX
+    static constexpr __UINT64_TYPE__ _S_math_abi_v3b = 0b0000011111'1111111110; // Haswell / Zen1-3
+    static constexpr __UINT64_TYPE__ _S_math_abi_v4  = 0b1111111111'1111111110; // Xeon / Zen4-5
+
+    // not a CPU feature: libsimd.so selects one of the above at load time (ifunc)
+    static constexpr __UINT64_TYPE__ _S_math_abi_dispatch = __UINT64_TYPE__(1) << 63;
+
     consteval _ArchTraits
     _M_math_abi() const
     {
-      // keep only SSE4.1, AVX, FMA, AVX512F, (AVX512FP16)
-      constexpr __UINT64_TYPE__ __v1_mask  = 0b0000000000'0000000110; // SSE2
-      constexpr __UINT64_TYPE__ __v2_mask  = 0b0000000000'0000111110; // SSE4.1
-      constexpr __UINT64_TYPE__ __v3a_mask = 0b0000000000'0111111110; // AVX
-      constexpr __UINT64_TYPE__ __v3b_mask = 0b0000011111'1111111110; // Haswell-...lake / Zen1-3
-      constexpr __UINT64_TYPE__ __v4_mask  = 0b1111111111'1111111110; // Xeon / Xen4-5
       // the FP16 flag is implied by passing float16_t vectors
-      if ((_M_flags & __v4_mask) == __v4_mask)
-	return _ArchTraits{__v4_mask};
-      if ((_M_flags & __v3b_mask) == __v3b_mask)
-	return _ArchTraits{__v3b_mask};
-      if ((_M_flags & __v3a_mask) == __v3a_mask)
-	return _ArchTraits{__v3a_mask};
-      if ((_M_flags & __v2_mask) == __v2_mask)
-	return _ArchTraits{__v2_mask};
-      if ((_M_flags & __v1_mask) == __v1_mask)
-	return _ArchTraits{__v1_mask};
+      if ((_M_flags & _S_math_abi_v4) == _S_math_abi_v4)
+	return _ArchTraits{_S_math_abi_v4};
+#if VIR_MATH_DISPATCH
+      // hardware might support a better math ABI than the one the caller is compiled for
+      if ((_M_flags & _S_math_abi_v1) == _S_math_abi_v1)
+	return _ArchTraits{_S_math_abi_dispatch};
+#endif
+      if ((_M_flags & _S_math_abi_v3b) == _S_math_abi_v3b)
+	return _ArchTraits{_S_math_abi_v3b};
+      if ((_M_flags & _S_math_abi_v3a) == _S_math_abi_v3a)
+	return _ArchTraits{_S_math_abi_v3a};
+      if ((_M_flags & _S_math_abi_v2) == _S_math_abi_v2)
+	return _ArchTraits{_S_math_abi_v2};
+      if ((_M_flags & _S_math_abi_v1) == _S_math_abi_v1)
+	return _ArchTraits{_S_math_abi_v1};
     }
 
 #endif
@@ -997,6 +1031,11 @@ namespace simd
     _M_have_xop() const
     { return _M_test(38); }
 
+    /// Code is tuned for AMD Zen (not an ISA extension, but a scheduling model).
+    consteval bool
+    _M_tune_zen() const
+    { return _M_test(39); }
+
     template <typename _Tp>
       consteval bool
       _M_eval_as_f32() const
@@ -1622,6 +1661,98 @@ namespace simd
       }
   }
 
+  /** @internal
+   * Packs the bits of @p __x where @p __sel is set into the low bits of the result (pext).
+   */
+  template <_ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    constexpr unsigned long long
+    __bit_compress(unsigned long long __x, unsigned long long __sel)
+    {
+#if _GLIBCXX_X86
+      if !consteval
+	{
+	  if constexpr (_Traits._M_have_bmi2())
+	    return __builtin_ia32_pext_di(__x, __sel);
+	}
+#endif
+      unsigned long long __r = 0;
+      int __j = 0;
+      __bit_foreach(__sel, [&] [[__gnu__::__always_inline__]] (int __i) {
+	__r |= ((__x >> __i) & 1) << __j++;
+      });
+      return __r;
+    }
+
+  /** @internal
+   * Deposits the low bits of @p __x at the positions where @p __sel is set (pdep).
+   */
+  template <_ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    constexpr unsigned long long
+    __bit_expand(unsigned long long __x, unsigned long long __sel)
+    {
+#if _GLIBCXX_X86
+      if !consteval
+	{
+	  if constexpr (_Traits._M_have_bmi2())
+	    return __builtin_ia32_pdep_di(__x, __sel);
+	}
+#endif
+      unsigned long long __r = 0;
+      int __j = 0;
+      __bit_foreach(__sel, [&] [[__gnu__::__always_inline__]] (int __i) {
+	__r |= ((__x >> __j++) & 1) << __i;
+      });
+      return __r;
+    }
+
+  /** @internal
+   * The smallest page size of all supported targets. Memory protection works with page
+   * granularity. Therefore, a read that does not cross a page boundary cannot fault if any of its
+   * bytes is readable.
+   */
+  inline constexpr size_t __min_page_size = 4096;
+
+#if defined __SANITIZE_ADDRESS__ || defined __SANITIZE_HWADDRESS__ || VIR_NO_OVERREAD
+#define _GLIBCXX_SIMD_NO_OVERREAD 1
+#elif defined __ARM_FEATURE_MEMORY_TAGGING || defined __CHERI__
+// memory tagging (16-byte granules) and capabilities (per object bounds) trap reads within a page
+#define _GLIBCXX_SIMD_NO_OVERREAD 1
+#elif defined __has_feature
+#if __has_feature(address_sanitizer) || __has_feature(hwaddress_sanitizer) \
+      || __has_feature(memory_sanitizer)
+#define _GLIBCXX_SIMD_NO_OVERREAD 1
+#endif
+#endif
+
+  /** @internal
+   * Whether partial loads may read past the end of the range if the read stays within a page
+   * (see __read_stays_within_page). Memory checkers report these reads, therefore this is
+   * disabled under AddressSanitizer, HWAddressSanitizer, and MemorySanitizer. Define
+   * VIR_NO_OVERREAD for other checkers, such as valgrind's memcheck. It is also disabled with
+   * Arm MTE and CHERI, where memory protection is finer than pages.
+   */
+#ifdef _GLIBCXX_SIMD_NO_OVERREAD
+  inline constexpr bool __allow_overread = false;
+#undef _GLIBCXX_SIMD_NO_OVERREAD
+#else
+  inline constexpr bool __allow_overread = true;
+#endif
+
+  /** @internal
+   * Returns whether [@p __ptr, @p __ptr + @p _Bytes) lies within a single page.
+   */
+  template <size_t _Bytes>
+    [[__gnu__::__always_inline__]]
+    inline bool
+    __read_stays_within_page(const void* __ptr)
+    {
+      static_assert(_Bytes > 0 && _Bytes <= __min_page_size);
+      return reinterpret_cast<__UINTPTR_TYPE__>(__ptr) % __min_page_size
+	       <= __min_page_size - _Bytes;
+    }
+
   /** @internal
    * Optimized @c memcpy for use in partial loads and stores.
    *
@@ -0,0 +1,496 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2025–2026 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef _GLIBCXX_SIMD_FFT_H
+#define _GLIBCXX_SIMD_FFT_H 1
+
+#ifdef _GLIBCXX_SYSHDR
+#pragma GCC system_header
+#endif
+
+#if __cplusplus >= 202400L
+
+#include "simd_complex.h"
+#include "simd_loadstore.h"
+
+#include <complex>
+#include <numbers>
+#include <vector>
+
+// psabi warnings are bogus because the ABI of the internal types never leaks into user code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#if VIR_EXTENSIONS
+// FFT (extension) ------------------------------------------------------------
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace simd
+{
+  enum class fft_direction
+  {
+    forward, ///< exp(-2πi jk/n)
+    inverse  ///< exp(+2πi jk/n), not normalized
+  };
+
+  /** @internal
+   * @brief Returns @p __z multiplied by -i (forward) or +i (inverse).
+   *
+   * Works for complex<T> and basic_vec<complex<T>> alike.
+   */
+  template <bool _Inverse, typename _Ep>
+    [[__gnu__::__always_inline__]]
+    constexpr _Ep
+    __fft_rot(const _Ep& __z)
+    {
+      if constexpr (_Inverse)
+	return _Ep(-__z.imag(), __z.real());
+      else
+	return _Ep(__z.imag(), -__z.real());
+    }
+
+  /** @internal
+   * @brief Returns @p __z multiplied by the real constant @p __c.
+   */
+  template <typename _Ep, typename _Rp>
+    [[__gnu__::__always_inline__]]
+    constexpr _Ep
+    __fft_scale(const _Ep& __z, _Rp __c)
+    {
+      if constexpr (__vectorizable<_Ep>)
+	return __z * __c;
+      else
+	return __z * _Ep(__c);
+    }
+
+  /** @internal
+   * @brief In-place DFT of length _Radix on @p __a.
+   */
+  template <bool _Inverse, typename _Ep, size_t _Radix>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    __fft_butterfly(_Ep (&__a)[_Radix])
+    {
+      using _Rp = typename conditional_t<__vectorizable<_Ep>, _Ep,
+					 typename _Ep::value_type>::value_type;
+      if constexpr (_Radix == 2)
+	{
+	  const _Ep __t = __a[0];
+	  __a[0] = __t + __a[1];
+	  __a[1] = __t - __a[1];
+	}
+      else if constexpr (_Radix == 3)
+	{
+	  constexpr _Rp __s60 = numbers::sqrt3_v<_Rp> / 2;
+	  const _Ep __t1 = __a[1] + __a[2];
+	  const _Ep __t2 = __a[0] - __fft_scale(__t1, _Rp(.5));
+	  const _Ep __t3 = __fft_rot<_Inverse>(__fft_scale(__a[1] - __a[2], __s60));
+	  __a[0] = __a[0] + __t1;
+	  __a[1] = __t2 + __t3;
+	  __a[2] = __t2 - __t3;
+	}
+      else if constexpr (_Radix == 4)
+	{
+	  const _Ep __t0 = __a[0] + __a[2];
+	  const _Ep __t1 = __a[0] - __a[2];
+	  const _Ep __t2 = __a[1] + __a[3];
+	  const _Ep __t3 = __fft_rot<_Inverse>(__a[1] - __a[3]);
+	  __a[0] = __t0 + __t2;
+	  __a[1] = __t1 + __t3;
+	  __a[2] = __t0 - __t2;
+	  __a[3] = __t1 - __t3;
+	}
+      else if constexpr (_Radix == 5)
+	{
+	  // cos and sin of 2π/5 and 4π/5
+	  constexpr _Rp __c1 = _Rp(0.309016994374947424102293417182819059L);
+	  constexpr _Rp __c2 = _Rp(-0.809016994374947424102293417182819059L);
+	  constexpr _Rp __s1 = _Rp(0.951056516295153572116439333379382143L);
+	  constexpr _Rp __s2 = _Rp(0.587785252292473129168705954639072769L);
+	  const _Ep __t1 = __a[1] + __a[4];
+	  const _Ep __t2 = __a[2] + __a[3];
+	  const _Ep __t3 = __a[1] - __a[4];
+	  const _Ep __t4 = __a[2] - __a[3];
+	  const _Ep __u1 = __a[0] + __fft_scale(__t1, __c1) + __fft_scale(__t2, __c2);
+	  const _Ep __u2 = __a[0] + __fft_scale(__t1, __c2) + __fft_scale(__t2, __c1);
+	  const _Ep __v1 = __fft_rot<_Inverse>(__fft_scale(__t3, __s1) + __fft_scale(__t4, __s2));
+	  const _Ep __v2 = __fft_rot<_Inverse>(__fft_scale(__t3, __s2) - __fft_scale(__t4, __s1));
+	  __a[0] = __a[0] + __t1 + __t2;
+	  __a[1] = __u1 + __v1;
+	  __a[4] = __u1 - __v1;
+	  __a[2] = __u2 + __v2;
+	  __a[3] = __u2 - __v2;
+	}
+      else
+	static_assert(false);
+    }
+
+  /** @internal
+   * @brief Load a _Vp from @p __p, which is either the same type or the value_type of _Vp.
+   */
+  template <typename _Vp, typename _Ep>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __fft_load(const _Ep* __p)
+    {
+      if constexpr (is_same_v<_Vp, _Ep>)
+	return *__p;
+      else
+	return unchecked_load<_Vp>(__p, _Vp::size());
+    }
+
+  template <typename _Vp, typename _Ep>
+    [[__gnu__::__always_inline__]]
+    inline void
+    __fft_store(const _Vp& __v, _Ep* __p)
+    {
+      if constexpr (is_same_v<_Vp, _Ep>)
+	*__p = __v;
+      else
+	unchecked_store(__v, __p, _Vp::size());
+    }
+
+  /** @internal
+   * @brief One butterfly of a Stockham autosort pass at (@p __j, @p __k), computing _Vp::size()
+   * neighboring k at once if _Vp is a vec.
+   */
+  template <size_t _Radix, bool _Inverse, typename _Vp, typename _Ep, typename _Cx>
+    [[__gnu__::__always_inline__]]
+    inline void
+    __fft_butterfly_at(size_t __m, size_t __s, size_t __j, size_t __k, const _Ep* __x, _Ep* __y,
+		       const _Cx* __wj)
+    {
+      _Vp __a[_Radix];
+      template for (constexpr int __q : _IotaArray<_Radix>)
+	__a[__q] = __fft_load<_Vp>(__x + __k + __s * (__j + __q * __m));
+      __fft_butterfly<_Inverse>(__a);
+      _Ep* __dst = __y + __k + __s * _Radix * __j;
+      __fft_store(__a[0], __dst);
+      if (__j == 0) // all twiddle factors are 1
+	template for (constexpr int __r : _IotaArray<_Radix - 1>)
+	  __fft_store(__a[__r + 1], __dst + __s * (__r + 1));
+      else
+	template for (constexpr int __r : _IotaArray<_Radix - 1>)
+	  __fft_store(__a[__r + 1] * _Vp(__wj[__r]), __dst + __s * (__r + 1));
+    }
+
+  /** @internal
+   * @brief A Stockham pass (see __fft_pass) with a stride smaller than _Vp::size(), vectorized
+   * over the flattened index t = j * s + k.
+   *
+   * The inputs of the butterflies are contiguous in t (@p __x[t + q * m * s]). The outputs are
+   * scattered and the twiddle factors gathered with indices computed from j = t / s and
+   * k = t % s.
+   */
+  template <size_t _Radix, bool _Inverse, typename _Vp, typename _Ep, typename _Cx>
+    inline void
+    __fft_pass_small_stride(size_t __m, size_t __s, const _Ep* __x, _Ep* __y, const _Cx* __tw)
+    {
+      using _IV = rebind_t<int, _Vp>;
+      constexpr int __w = _Vp::size();
+      const int __si = int(__s);
+      const size_t __ms = __m * __s;
+      const span<const _Cx> __tws(__tw, __m * (_Radix - 1));
+      const span<_Ep> __ys(__y, __ms * _Radix);
+      const _IV __iota([](int __i) { return __i; });
+      _IV __j = __iota / __si;
+      _IV __k = __iota - __j * __si;
+      size_t __t = 0;
+      for (; __t + __w <= __ms; __t += __w)
+	{
+	  _Vp __a[_Radix];
+	  template for (constexpr int __q : _IotaArray<_Radix>)
+	    __a[__q] = unchecked_load<_Vp>(__x + __t + __q * __ms, __w);
+	  __fft_butterfly<_Inverse>(__a);
+	  const _IV __dst = __k + __j * (__si * int(_Radix));
+	  unchecked_scatter_to(__a[0], __ys, __dst);
+	  template for (constexpr int __r : _IotaArray<_Radix - 1>)
+	    {
+	      const _Vp __wr = unchecked_gather_from<_Vp>(__tws, __j * int(_Radix - 1) + __r);
+	      unchecked_scatter_to(__a[__r + 1] * __wr, __ys, __dst + __si * (__r + 1));
+	    }
+	  // advance (j, k) by __w
+	  __j += __w / __si;
+	  __k += __w % __si;
+	  const auto __carry = __k >= __si;
+	  __k = select(__carry, __k - __si, __k);
+	  __j = select(__carry, __j + 1, __j);
+	}
+      for (; __t < __ms; ++__t)
+	{
+	  const size_t __jt = __t / __s;
+	  __fft_butterfly_at<_Radix, _Inverse, _Ep>(__m, __s, __jt, __t % __s, __x, __y,
+						    __tw + __jt * (_Radix - 1));
+	}
+    }
+
+  /** @internal
+   * @brief One Stockham autosort pass (decimation in frequency).
+   *
+   * Reads @p __x and writes @p __y. The sub-transform length is _Radix * @p __m, the stride
+   * (number of interleaved sub-transforms) is @p __s. If _Ep is a complex value, the loop over
+   * the stride is vectorized with vec<_Ep> (or the loop over all butterflies, if the stride is
+   * smaller than the vec), otherwise every _Ep is a batch of independent transforms (SoA).
+   */
+  template <size_t _Radix, bool _Inverse, typename _Ep, typename _Cx>
+    inline void
+    __fft_pass(size_t __m, size_t __s, const _Ep* __x, _Ep* __y, const _Cx* __tw)
+    {
+      if constexpr (__vectorizable<_Ep>)
+	if (__s < size_t(vec<_Ep>::size()))
+	  {
+	    __fft_pass_small_stride<_Radix, _Inverse, vec<_Ep>>(__m, __s, __x, __y, __tw);
+	    return;
+	  }
+      for (size_t __j = 0; __j < __m; ++__j)
+	{
+	  const _Cx* __wj = __tw + __j * (_Radix - 1);
+	  size_t __k = 0;
+	  if constexpr (__vectorizable<_Ep>)
+	    {
+	      using _Vp = vec<_Ep>;
+	      for (; __k + _Vp::size() <= __s; __k += _Vp::size())
+		__fft_butterfly_at<_Radix, _Inverse, _Vp>(__m, __s, __j, __k, __x, __y, __wj);
+	    }
+	  for (; __k < __s; ++__k)
+	    __fft_butterfly_at<_Radix, _Inverse, _Ep>(__m, __s, __j, __k, __x, __y, __wj);
+	}
+    }
+
+  /** @internal
+   * @brief One butterfly of a Stockham pass with an arbitrary radix @p __p, as a plain DFT.
+   *
+   * @p __roots are the @p __p-th roots of unity (with the sign of the transform direction).
+   */
+  template <typename _Vp, typename _Ep, typename _Cx>
+    [[__gnu__::__always_inline__]]
+    inline void
+    __fft_dft_at(size_t __p, size_t __m, size_t __s, size_t __j, size_t __k, const _Ep* __x,
+		 _Ep* __y, const _Cx* __wj, const _Cx* __roots)
+    {
+      const _Ep* __src = __x + __k + __s * __j;
+      _Ep* __dst = __y + __k + __s * __p * __j;
+      for (size_t __r = 0; __r < __p; ++__r)
+	{
+	  _Vp __b = __fft_load<_Vp>(__src);
+	  for (size_t __q = 1; __q < __p; ++__q)
+	    __b = __b + __fft_load<_Vp>(__src + __s * __q * __m) * _Vp(__roots[__q * __r % __p]);
+	  if (__r > 0)
+	    __b = __b * _Vp(__wj[__r - 1]);
+	  __fft_store(__b, __dst + __s * __r);
+	}
+    }
+
+  /** @internal
+   * @brief A Stockham pass with the prime radix @p __p > 5, computing O(p²) DFTs.
+   *
+   * The @p __p roots of unity follow the twiddle factors of the pass in @p __tw.
+   */
+  template <typename _Ep, typename _Cx>
+    inline void
+    __fft_dft_pass(size_t __p, size_t __m, size_t __s, const _Ep* __x, _Ep* __y, const _Cx* __tw)
+    {
+      const _Cx* __roots = __tw + __m * (__p - 1);
+      for (size_t __j = 0; __j < __m; ++__j)
+	{
+	  const _Cx* __wj = __tw + __j * (__p - 1);
+	  size_t __k = 0;
+	  if constexpr (__vectorizable<_Ep>)
+	    {
+	      using _Vp = vec<_Ep>;
+	      for (; __k + _Vp::size() <= __s; __k += _Vp::size())
+		__fft_dft_at<_Vp>(__p, __m, __s, __j, __k, __x, __y, __wj, __roots);
+	    }
+	  for (; __k < __s; ++__k)
+	    __fft_dft_at<_Ep>(__p, __m, __s, __j, __k, __x, __y, __wj, __roots);
+	}
+    }
+
+  /** @brief A precomputed mixed-radix (2, 3, 4, 5) FFT of a fixed size.
+   *
+   * Other prime factors of the size are computed as plain DFTs, which need O(p²) operations per
+   * factor p.
+   *
+   * The plan holds the factorization and the twiddle tables of all passes. Transforms never
+   * allocate; the caller provides a work buffer of size() elements. The inverse transform is not
+   * normalized.
+   *
+   * The transform can be applied to complex<_Tp> arrays (vectorized internally) or to arrays of
+   * basic_vec<complex<_Tp>>, where every lane is an independent transform (batched, SoA).
+   */
+  template <floating_point _Tp>
+    class fft_plan
+    {
+      struct _Pass
+      {
+	int _M_radix;
+	size_t _M_m;
+	size_t _M_s;
+	size_t _M_tw;
+      };
+
+      size_t _M_n;
+
+      fft_direction _M_dir;
+
+      std::vector<_Pass> _M_passes;
+
+      std::vector<complex<_Tp>> _M_twiddles;
+
+    public:
+      using value_type = complex<_Tp>;
+
+      explicit
+      fft_plan(size_t __n, fft_direction __dir = fft_direction::forward)
+      : _M_n(__n), _M_dir(__dir)
+      {
+	__glibcxx_simd_precondition(__n > 0, "FFT size must be positive");
+	using _Lp = long double;
+	const _Lp __sign = __dir == fft_direction::forward ? -1 : 1;
+	size_t __len = __n;
+	size_t __s = 1;
+	while (__len > 1)
+	  {
+	    int __p = __len % 4 == 0 ? 4 : __len % 2 == 0 ? 2 : __len % 3 == 0 ? 3
+							: __len % 5 == 0 ? 5 : 0;
+	    if (__p == 0) // the smallest prime factor, computed as a plain DFT
+	      for (__p = 7; __len % __p != 0; __p += 2)
+		;
+	    const size_t __m = __len / __p;
+	    _M_passes.push_back({__p, __m, __s, _M_twiddles.size()});
+	    for (size_t __j = 0; __j < __m; ++__j)
+	      for (int __r = 1; __r < __p; ++__r)
+		{
+		  const _Lp __phi = __sign * 2 * numbers::pi_v<_Lp> * _Lp(__j * __r % __len)
+				      / _Lp(__len);
+		  _M_twiddles.emplace_back(_Tp(std::cos(__phi)), _Tp(std::sin(__phi)));
+		}
+	    if (__p > 5)
+	      for (int __r = 0; __r < __p; ++__r)
+		{
+		  const _Lp __phi = __sign * 2 * numbers::pi_v<_Lp> * _Lp(__r) / _Lp(__p);
+		  _M_twiddles.emplace_back(_Tp(std::cos(__phi)), _Tp(std::sin(__phi)));
+		}
+	    __s *= __p;
+	    __len = __m;
+	  }
+      }
+
+      /// The transform length.
+      size_t
+      size() const noexcept
+      { return _M_n; }
+
+      fft_direction
+      direction() const noexcept
+      { return _M_dir; }
+
+      /// Out-of-place transform of complex values.
+      void
+      operator()(span<const value_type> __in, span<value_type> __out,
+		 span<value_type> __work) const
+      {
+	_M_run(__in.data(), __out.data(), __work.data(), __in.size(), __out.size(),
+	       __work.size());
+      }
+
+      /// In-place transform of complex values.
+      void
+      operator()(span<value_type> __data, span<value_type> __work) const
+      {
+	_M_run(__data.data(), __data.data(), __work.data(), __data.size(), __data.size(),
+	       __work.size());
+      }
+
+      /// Out-of-place batched transform: every lane of the vecs is an independent transform.
+      template <typename _Ap>
+	void
+	operator()(span<const basic_vec<value_type, _Ap>> __in,
+		   span<basic_vec<value_type, _Ap>> __out,
+		   span<basic_vec<value_type, _Ap>> __work) const
+	{
+	  _M_run(__in.data(), __out.data(), __work.data(), __in.size(), __out.size(),
+		 __work.size());
+	}
+
+      /// In-place batched transform: every lane of the vecs is an independent transform.
+      template <typename _Ap>
+	void
+	operator()(span<basic_vec<value_type, _Ap>> __data,
+		   span<basic_vec<value_type, _Ap>> __work) const
+	{
+	  _M_run(__data.data(), __data.data(), __work.data(), __data.size(), __data.size(),
+		 __work.size());
+	}
+
+    private:
+      template <typename _Ep>
+	void
+	_M_run(const _Ep* __in, _Ep* __out, _Ep* __work, size_t __nin, size_t __nout,
+	       size_t __nwork) const
+	{
+	  __glibcxx_simd_precondition(__nin == _M_n && __nout == _M_n && __nwork >= _M_n,
+				      "input and output must have size() elements, the work buffer "
+				      "at least size() elements");
+	  const size_t __npasses = _M_passes.size();
+	  if (__npasses == 0)
+	    {
+	      if (__in != __out)
+		__out[0] = __in[0];
+	      return;
+	    }
+	  // ping-pong between __out and __work such that the last pass writes __out
+	  const _Ep* __src = __in;
+	  if (__in == __out && __npasses % 2 == 1)
+	    { // the first pass would overwrite its own input
+	      for (size_t __i = 0; __i < _M_n; ++__i)
+		__work[__i] = __in[__i];
+	      __src = __work;
+	    }
+	  for (size_t __i = 0; __i < __npasses; ++__i)
+	    {
+	      _Ep* __dst = (__npasses - 1 - __i) % 2 == 0 ? __out : __work;
+	      const _Pass& __pass = _M_passes[__i];
+	      const value_type* __tw = _M_twiddles.data() + __pass._M_tw;
+	      if (_M_dir == fft_direction::forward)
+		_M_pass<false>(__pass, __src, __dst, __tw);
+	      else
+		_M_pass<true>(__pass, __src, __dst, __tw);
+	      __src = __dst;
+	    }
+	}
+
+      template <bool _Inverse, typename _Ep>
+	static void
+	_M_pass(const _Pass& __pass, const _Ep* __x, _Ep* __y, const value_type* __tw)
+	{
+	  switch (__pass._M_radix)
+	    {
+	    case 2:
+	      __fft_pass<2, _Inverse>(__pass._M_m, __pass._M_s, __x, __y, __tw);
+	      break;
+	    case 3:
+	      __fft_pass<3, _Inverse>(__pass._M_m, __pass._M_s, __x, __y, __tw);
+	      break;
+	    case 4:
+	      __fft_pass<4, _Inverse>(__pass._M_m, __pass._M_s, __x, __y, __tw);
+	      break;
+	    case 5:
+	      __fft_pass<5, _Inverse>(__pass._M_m, __pass._M_s, __x, __y, __tw);
+	      break;
+	    default:
+	      __fft_dft_pass(__pass._M_radix, __pass._M_m, __pass._M_s, __x, __y, __tw);
+	    }
+	}
+    };
+} // namespace simd
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+#endif // VIR_EXTENSIONS
+
+#pragma GCC diagnostic pop
+#endif // C++26
+#endif // _GLIBCXX_SIMD_FFT_H
@@ -95,29 +95,100 @@ namespace simd
   : _LoadStoreTag
   {};
 
-  template <int _L1, int _L2 /*, exclusive vs. shared*/>
+  struct __read_modify_write_flag
+  : _LoadStoreTag
+  {};
+
+  struct __padded_flag
+  : _LoadStoreTag
+  {};
+
+  /** @brief Cache level hint for prefetches (extension).
+   *
+   * The enumerator values are the locality argument of __builtin_prefetch.
+   */
+  enum class prefetch_hint
+  {
+    /// Non-temporal: fetch close to the core, but minimize cache pollution (prefetchnta).
+    nta,
+    /// Into L3 and farther (prefetcht2).
+    t2,
+    /// Into L2 and farther (prefetcht1).
+    t1,
+    /// Into all cache levels (prefetcht0).
+    t0
+  };
+
+  /** @internal
+   * The cache line size assumed for prefetching.
+   */
+  inline constexpr size_t __prefetch_line_size = __GCC_CONSTRUCTIVE_SIZE;
+
+  /** @internal
+   * Prefetches every cache line of the @p _Bytes bytes starting at @p __addr, which is aligned to
+   * @p _Align.
+   *
+   * The address is an integer: the prefetched memory may lie past the end of a range, but
+   * prefetches never fault.
+   */
+  template <prefetch_hint _Hint, bool _Write, size_t _Bytes, size_t _Align = 1>
+    [[__gnu__::__always_inline__]]
+    inline void
+    __prefetch_bytes(__UINTPTR_TYPE__ __addr)
+    {
+      static_assert(_Bytes > 0 && __has_single_bit(_Align));
+      constexpr size_t __line_size = __prefetch_line_size;
+      constexpr int __lines = __div_ceil(_Bytes, __line_size);
+      template for (constexpr int __line : _IotaArray<__lines>)
+	__builtin_prefetch(reinterpret_cast<const void*>(__addr + __line * __line_size),
+			   _Write, int(_Hint));
+      // Depending on __addr % __line_size the bytes can span one more line. Prefetching the line
+      // of the last byte is cheaper than computing the number of lines at runtime (without an
+      // extra line it is the line of the last prefetch above).
+      constexpr size_t __max_offset = _Align < __line_size ? __line_size - _Align : 0;
+      if constexpr (__max_offset + _Bytes - 1 >= __lines * __line_size)
+	__builtin_prefetch(reinterpret_cast<const void*>(__addr + _Bytes - 1), _Write, int(_Hint));
+    }
+
+  /** @internal
+   * Prefetch hint (extension): loads and stores additionally prefetch the memory @p _L1 vecs
+   * ahead into L1 (prefetcht0), @p _L2 vecs ahead into L2 (prefetcht1), @p _L3 vecs ahead into
+   * L3 (prefetcht2), and @p _Nta vecs ahead non-temporally (prefetchnta). A distance of 0
+   * disables the respective prefetch. Vecs wider than a cache line prefetch all of their cache
+   * lines. Stores prefetch with intent to write (prefetchw, if enabled via -mprfchw).
+   */
+  template <int _L1, int _L2, int _L3 = 0, int _Nta = 0>
     struct __prefetch_flag
     : _LoadStoreTag
     {
-      template <typename, typename _Up>
+      static_assert(_L1 >= 0 && _L2 >= 0 && _L3 >= 0 && _Nta >= 0,
+		    "prefetch distances must not be negative");
+
+      template <prefetch_hint _Hint, int _Dist, typename _Tp, typename _Up>
 	[[__gnu__::__always_inline__]]
-	static _Up*
+	static void
+	_S_prefetch(_Up* __ptr)
+	{
+	  if constexpr (_Dist > 0)
+	    {
+	      constexpr size_t __bytes = _Tp::size() * sizeof(_Up);
+	      __prefetch_bytes<_Hint, !is_const_v<_Up>, __bytes, alignof(_Up)>(
+		reinterpret_cast<__UINTPTR_TYPE__>(__ptr) + _Dist * __bytes);
+	    }
+	}
+
+      template <typename _Tp, typename _Up>
+	[[__gnu__::__always_inline__]]
+	static constexpr _Up*
 	_S_adjust_pointer(_Up* __ptr)
 	{
-	  // one read: 0, 0
-	  // L1: 0, 1
-	  // L2: 0, 2
-	  // L3: 0, 3
-	  // (exclusive cache line) for writing: 1, 0 / 1, 1
-	  /*          constexpr int __write = 1;
-		      constexpr int __level = 0-3;
-	  __builtin_prefetch(__ptr, __write, __level)
-	  _mm_prefetch(reinterpret_cast<char const*>(__ptr), _MM_HINT_T0);
-	  _mm_prefetch(reinterpret_cast<char const*>(__ptr), _MM_HINT_T1);
-	  _mm_prefetch(reinterpret_cast<char const*>(__ptr), _MM_HINT_T2);
-	  _mm_prefetch(reinterpret_cast<char const*>(__ptr), _MM_HINT_ET0);
-	  _mm_prefetch(reinterpret_cast<char const*>(__ptr), _MM_HINT_ET1);
-	  _mm_prefetch(reinterpret_cast<char const*>(__ptr), _MM_HINT_NTA);*/
+	  if !consteval
+	    {
+	      _S_prefetch<prefetch_hint::t0, _L1, _Tp>(__ptr);
+	      _S_prefetch<prefetch_hint::t1, _L2, _Tp>(__ptr);
+	      _S_prefetch<prefetch_hint::t2, _L3, _Tp>(__ptr);
+	      _S_prefetch<prefetch_hint::nta, _Nta, _Tp>(__ptr);
+	    }
 	  return __ptr;
 	}
     };
@@ -200,10 +271,51 @@ namespace simd
   // extensions
   inline constexpr flags<__throw_flag> __flag_throw {};
 
+  /** @brief Load / store hint for data that is touched only once.
+   *
+   * unchecked_load and unchecked_store use non-temporal instructions (x86: movntdqa for loads,
+   * movntps / movntpd / movntdq for stores), which avoid evicting the working set from the cache.
+   * This only applies to registers whose address is aligned to the register size; other
+   * addresses fall back to regular loads and stores. Streaming through a large array should
+   * therefore use regular (partial) stores for the unaligned head until the output pointer is
+   * aligned to alignment_v<V>, and __flag_streaming for the rest. Masked and partial loads /
+   * stores ignore the flag.
+   *
+   * Non-temporal stores are weakly ordered: call __streaming_fence() before other threads read
+   * the data.
+   */
   inline constexpr flags<__streaming_flag> __flag_streaming {};
 
-  template <int _L1, int _L2>
-    inline constexpr flags<__prefetch_flag<_L1, _L2>> __flag_prefetch {};
+  /** @brief Allows masked stores to load, blend, and store the complete vec.
+   *
+   * Without AVX-512, masked stores of 1- and 2-byte elements (and of all elements without AVX)
+   * otherwise store element by element, and vmaskmov stores are slow on some CPUs. With this flag,
+   * the caller guarantees that no other thread concurrently writes any of the elements of the
+   * destination range that are not selected by the mask. The flag is ignored if the elements need
+   * a conversion or if the output range is smaller than the vec (partial_store).
+   */
+  inline constexpr flags<__read_modify_write_flag> __flag_read_modify_write {};
+
+  /** @brief Allows partial loads and stores to access the complete vec.
+   *
+   * With this flag, the caller guarantees that the memory of V::size() elements starting at the
+   * given pointer is allocated, and that the elements past the end of the range may be
+   * overwritten (no other thread accesses them). This holds for the tails of loops over
+   * padded_vector (see aligned_allocator) that step by V::size() from the beginning. Partial loads
+   * then load the complete vec and zero the elements past the end; partial stores store the
+   * complete vec.
+   */
+  inline constexpr flags<__padded_flag> __flag_padded {};
+
+  /** @brief Prefetch @p _L1 vecs ahead into L1, @p _L2 vecs ahead into L2, @p _L3 vecs ahead
+   * into L3, and @p _Nta vecs ahead non-temporally (0: no prefetch).
+   *
+   * For example, a loop over a large array with @c unchecked_load<V>(ptr + i,
+   * __flag_prefetch<16, 64>) keeps the next 16 vecs in flight to L1 and the next 64 to L2.
+   * Gathers and scatters ignore the flag; use prefetch(range, future_indices) instead.
+   */
+  template <int _L1, int _L2, int _L3 = 0, int _Nta = 0>
+    inline constexpr flags<__prefetch_flag<_L1, _L2, _L3, _Nta>> __flag_prefetch {};
 #endif
 } // namespace simd
 _GLIBCXX_END_NAMESPACE_VERSION
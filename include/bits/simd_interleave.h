@@ -0,0 +1,256 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef _GLIBCXX_SIMD_INTERLEAVE_H
+#define _GLIBCXX_SIMD_INTERLEAVE_H 1
+
+#ifdef _GLIBCXX_SYSHDR
+#pragma GCC system_header
+#endif
+
+#if __cplusplus >= 202400L
+
+#include "simd_loadstore.h"
+
+#include <array>
+
+// psabi warnings are bogus because the ABI of the internal types never leaks into user code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#if VIR_EXTENSIONS
+// Interleaved (structured) loads and stores (extension) ----------------------
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace simd
+{
+  /** @internal
+   * Returns the number of elements of the vecs that are deinterleaved / interleaved as a unit. If
+   * @p _Vp spans several native registers, each group of native registers is handled on its own
+   * and the results are concatenated. This keeps all permutes within two registers.
+   */
+  template <typename _Vp>
+    consteval int
+    __interleave_chunk_size()
+    {
+      constexpr int __native = vec<typename _Vp::value_type>::size();
+      if (_Vp::size() > __native && _Vp::size() % __native == 0)
+	return __native;
+      else
+	return _Vp::size();
+    }
+
+  /** @internal
+   * @brief Deinterleaves @p __c, which holds _Np * _Cp::size() consecutive elements of an array of
+   * structs with @p _Np members, into one vec per member.
+   *
+   * For powers of two, this is a network of log2(_Np) rounds, where every round splits
+   * neighboring pairs of vecs into their even and odd elements (one two-register permute each).
+   * Otherwise, every member is permuted out of the concatenation of all @p _Np vecs.
+   */
+  template <size_t _Np, typename _Cp>
+    [[__gnu__::__always_inline__]]
+    constexpr array<_Cp, _Np>
+    __aos_to_soa(const array<_Cp, _Np>& __c)
+    {
+      if constexpr (_Np == 1)
+	return __c;
+      else if constexpr (__has_single_bit(_Np))
+	{
+	  array<_Cp, _Np> __r = __c;
+	  for (size_t __round = 1; __round < _Np; __round *= 2)
+	    {
+	      const array<_Cp, _Np> __a = __r;
+	      template for (constexpr int __k : _IotaArray<_Np / 2>)
+		{
+		  const auto __ab = cat(__a[2 * __k], __a[2 * __k + 1]);
+		  __r[__k] = _Cp::_S_static_permute(__ab, [](int __i) consteval {
+			       return 2 * __i;
+			     });
+		  __r[__k + _Np / 2] = _Cp::_S_static_permute(__ab, [](int __i) consteval {
+					 return 2 * __i + 1;
+				       });
+		}
+	    }
+	  return __r;
+	}
+      else
+	{
+	  constexpr auto [...__is] = _IotaArray<_Np>;
+	  const auto __all = cat(__c[__is]...);
+	  array<_Cp, _Np> __r;
+	  template for (constexpr int __j : _IotaArray<_Np>)
+	    __r[__j] = _Cp::_S_static_permute(__all, [](int __i) consteval {
+			 return __i * int(_Np) + __j;
+		       });
+	  return __r;
+	}
+    }
+
+  /** @internal
+   * @brief Inverse of __aos_to_soa: returns the _Np * _Cp::size() consecutive elements of an
+   * array of structs with @p _Np members, given one vec per member.
+   *
+   * For powers of two, every round zips pairs of vecs (interleave low / high halves).
+   */
+  template <size_t _Np, typename _Cp>
+    [[__gnu__::__always_inline__]]
+    constexpr array<_Cp, _Np>
+    __soa_to_aos(const array<_Cp, _Np>& __m)
+    {
+      constexpr int __s = _Cp::size();
+      if constexpr (_Np == 1)
+	return __m;
+      else if constexpr (__has_single_bit(_Np))
+	{
+	  array<_Cp, _Np> __r = __m;
+	  for (size_t __round = 1; __round < _Np; __round *= 2)
+	    {
+	      const array<_Cp, _Np> __a = __r;
+	      template for (constexpr int __k : _IotaArray<_Np / 2>)
+		{
+		  const auto __xy = cat(__a[__k], __a[__k + _Np / 2]);
+		  __r[2 * __k] = _Cp::_S_static_permute(__xy, [](int __i) consteval {
+				   return (__i & 1) * __s + __i / 2;
+				 });
+		  __r[2 * __k + 1] = _Cp::_S_static_permute(__xy, [](int __i) consteval {
+				       return ((__i + __s) & 1) * __s + (__i + __s) / 2;
+				     });
+		}
+	    }
+	  return __r;
+	}
+      else
+	{
+	  constexpr auto [...__is] = _IotaArray<_Np>;
+	  const auto __all = cat(__m[__is]...);
+	  array<_Cp, _Np> __r;
+	  template for (constexpr int __k : _IotaArray<_Np>)
+	    __r[__k] = _Cp::_S_static_permute(__all, [](int __i) consteval {
+			 const int __j = __k * __s + __i;
+			 return __j % int(_Np) * __s + __j / int(_Np);
+		       });
+	  return __r;
+	}
+    }
+
+  /** @brief Loads @p _Np vecs from the array of structs @p __r, where every struct consists of @p
+   * _Np elements: element i of the j-th returned vec is @p __r[i * _Np + j].
+   *
+   * This is the equivalent of ARM's vld2/vld3/vld4: the input is read with contiguous loads and
+   * deinterleaved with permutes. Use structured bindings for the result:
+   * @code
+   * const auto [x, y, z] = load_interleaved<3>(points); // points is a range of float
+   * @endcode
+   *
+   * @pre ranges::size(@p __r) >= _Np * V::size(), where V is the returned vec type.
+   */
+  template <size_t _Np, typename _Vp = void, __sized_contiguous_range _Rg, typename... _Flags>
+    requires (_Np >= 1) && (!__complex_like<ranges::range_value_t<_Rg>>)
+    [[__gnu__::__always_inline__]]
+    constexpr array<__vec_load_return_t<_Vp, ranges::range_value_t<_Rg>>, _Np>
+    load_interleaved(_Rg&& __r, flags<_Flags...> __f = {})
+    {
+      using _RV = __vec_load_return_t<_Vp, ranges::range_value_t<_Rg>>;
+      constexpr int __s = __interleave_chunk_size<_RV>();
+      constexpr int __groups = _RV::size() / __s;
+      using _Cp = conditional_t<__groups == 1, _RV, resize_t<__s, _RV>>;
+      if constexpr (__static_sized_range<_Rg>)
+	static_assert(ranges::size(__r) >= _Np * _RV::size(),
+		      "given range must have sufficient size");
+      __glibcxx_simd_precondition(ranges::size(__r) >= _Np * _RV::size(),
+				  "input range is too small");
+      const auto* __ptr = ranges::data(__r);
+      array<array<_Cp, _Np>, __groups> __parts;
+      template for (constexpr int __g : _IotaArray<__groups>)
+	{
+	  array<_Cp, _Np> __c;
+	  template for (constexpr int __k : _IotaArray<_Np>)
+	    __c[__k] = unchecked_load<_Cp>(__ptr + (__g * int(_Np) + __k) * __s, __s, __f);
+	  __parts[__g] = __aos_to_soa(__c);
+	}
+      if constexpr (__groups == 1)
+	return __parts[0];
+      else
+	{
+	  constexpr auto [...__gs] = _IotaArray<__groups>;
+	  array<_RV, _Np> __ret;
+	  template for (constexpr int __j : _IotaArray<_Np>)
+	    __ret[__j] = _RV::_S_concat(__parts[__gs][__j]...);
+	  return __ret;
+	}
+    }
+
+  template <size_t _Np, typename _Vp = void, contiguous_iterator _It, typename... _Flags>
+    requires (_Np >= 1) && (!__complex_like<iter_value_t<_It>>)
+    [[__gnu__::__always_inline__]]
+    constexpr array<__vec_load_return_t<_Vp, iter_value_t<_It>>, _Np>
+    load_interleaved(_It __first, flags<_Flags...> __f = {})
+    {
+      constexpr size_t __n = _Np * __vec_load_return_t<_Vp, iter_value_t<_It>>::size();
+      return simd::load_interleaved<_Np, _Vp>(span<const iter_value_t<_It>, __n>(__first, __n),
+					      __f);
+    }
+
+  /** @brief Stores the @p _Np vecs @p __v to the array of structs @p __r, where every struct
+   * consists of @p _Np elements: @p __r[i * _Np + j] is set to element i of @p __v[j].
+   *
+   * This is the inverse of load_interleaved (and the equivalent of ARM's vst2/vst3/vst4).
+   *
+   * @pre ranges::size(@p __r) >= _Np * _Vp::size().
+   */
+  template <size_t _Np, __simd_vec_type _Vp, __sized_contiguous_range _Rg, typename... _Flags>
+    requires (_Np >= 1) && (!__complex_like<typename _Vp::value_type>)
+	       && indirectly_writable<ranges::iterator_t<_Rg>, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    store_interleaved(const array<_Vp, _Np>& __v, _Rg&& __r, flags<_Flags...> __f = {})
+    {
+      constexpr int __s = __interleave_chunk_size<_Vp>();
+      constexpr int __groups = _Vp::size() / __s;
+      using _Cp = conditional_t<__groups == 1, _Vp, resize_t<__s, _Vp>>;
+      if constexpr (__static_sized_range<_Rg>)
+	static_assert(ranges::size(__r) >= _Np * _Vp::size(),
+		      "given range must have sufficient size");
+      __glibcxx_simd_precondition(ranges::size(__r) >= _Np * _Vp::size(),
+				  "output range is too small");
+      auto* __ptr = ranges::data(__r);
+      array<array<_Cp, _Np>, __groups> __parts;
+      if constexpr (__groups == 1)
+	__parts[0] = __v;
+      else
+	template for (constexpr int __j : _IotaArray<_Np>)
+	  {
+	    const auto __chunks = chunk<_Cp>(__v[__j]);
+	    template for (constexpr int __g : _IotaArray<__groups>)
+	      __parts[__g][__j] = __chunks[__g];
+	  }
+      template for (constexpr int __g : _IotaArray<__groups>)
+	{
+	  const array<_Cp, _Np> __c = __soa_to_aos(__parts[__g]);
+	  template for (constexpr int __k : _IotaArray<_Np>)
+	    unchecked_store(__c[__k], __ptr + (__g * int(_Np) + __k) * __s, __s, __f);
+	}
+    }
+
+  template <size_t _Np, __simd_vec_type _Vp, contiguous_iterator _It, typename... _Flags>
+    requires (_Np >= 1) && (!__complex_like<typename _Vp::value_type>)
+	       && indirectly_writable<_It, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    store_interleaved(const array<_Vp, _Np>& __v, _It __first, flags<_Flags...> __f = {})
+    {
+      constexpr size_t __n = _Np * _Vp::size();
+      simd::store_interleaved(__v, span<iter_value_t<_It>, __n>(__first, __n), __f);
+    }
+} // namespace simd
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+#endif // VIR_EXTENSIONS
+
+#pragma GCC diagnostic pop
+#endif // C++26
+#endif // _GLIBCXX_SIMD_INTERLEAVE_H
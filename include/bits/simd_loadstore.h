@@ -42,6 +42,26 @@ namespace simd
     concept __sized_contiguous_range
       = ranges::contiguous_range<_Tp> && ranges::sized_range<_Tp>;
 
+#if VIR_EXTENSIONS
+  /** @internal
+   * Number of bytes starting at ranges::data(r) that are allocated for every non-empty range r of
+   * type @p _Rg, independent of its size. Specialized for padded_vector (simd_allocator.h).
+   */
+  template <typename _Rg>
+    constexpr size_t __padded_range_bytes = 0;
+
+  /** @internal
+   * True if partial loads / stores of @p _Vp from / to a range of type @p _Rg may access all of
+   * _Vp::size() elements (see __flag_padded).
+   */
+  template <typename _Vp, typename _Rg, typename... _Flags>
+    constexpr bool __padded_access
+      = _Vp::size() > 1
+	  && (flags<_Flags...>::_S_test(__flag_padded)
+		|| _Vp::size() * sizeof(ranges::range_value_t<_Rg>)
+		     <= __padded_range_bytes<remove_cvref_t<_Rg>>);
+#endif
+
   template <typename _Vp = void, __sized_contiguous_range _Rg, typename... _Flags>
     [[__gnu__::__always_inline__]]
     constexpr __vec_load_return_t<_Vp, ranges::range_value_t<_Rg>>
@@ -81,7 +101,25 @@ namespace simd
 	{
 	  if constexpr ((__static_size != dynamic_extent && __static_size >= size_t(_RV::size()))
 			  || !__allow_out_of_bounds)
-	    return _RV(_LoadCtorTag(), __ptr);
+	    {
+#if VIR_EXTENSIONS
+	      if constexpr (__f._S_test(__flag_streaming) && !__complex_like<_Rp>)
+		return _RV::_S_streaming_load(__ptr);
+#endif
+	      return _RV(_LoadCtorTag(), __ptr);
+	    }
+#if VIR_EXTENSIONS
+	  else if constexpr (__padded_access<_RV, _Rg, _Flags...>)
+	    {
+	      if (__rg_size >= size_t(_RV::size()))
+		return _RV(_LoadCtorTag(), __ptr);
+	      else if (__rg_size == 0)
+		return _RV();
+	      else
+		return __select_impl(_RV::mask_type::_S_partial_mask_of_n(int(__rg_size)),
+				     _RV(_LoadCtorTag(), __ptr), _RV());
+	    }
+#endif
 	  else
 	    return _RV::_S_partial_load(__ptr, __rg_size);
 	}
@@ -250,8 +288,21 @@ namespace simd
 	}
       else
 	{
+#if VIR_EXTENSIONS
+	  if constexpr (!__allow_out_of_bounds && __f._S_test(__flag_streaming)
+			  && !__complex_like<_Tp>)
+	    _TV::_S_streaming_store(__v, __ptr);
+	  else
+#endif
 	  if constexpr (!__allow_out_of_bounds)
 	    __v._M_store(__ptr);
+#if VIR_EXTENSIONS
+	  else if constexpr (__padded_access<_TV, _Rg, _Flags...>)
+	    {
+	      if (__rg_size > 0)
+		__v._M_store(__ptr);
+	    }
+#endif
 	  else
 	    _TV::_S_partial_store(__v, __ptr, __rg_size);
 	}
@@ -281,6 +332,15 @@ namespace simd
 	  "output range is too small. Did you mean to use 'partial_store'?");
 
       const size_t __rg_size = ranges::size(__r);
+#if VIR_EXTENSIONS
+      if constexpr (__f._S_test(__flag_read_modify_write) && !__complex_like<_Tp>
+		      && __converts_trivially<_Tp, ranges::range_value_t<_Rg>>)
+	if (!__allow_out_of_bounds || __rg_size >= size_t(_TV::size()))
+	  {
+	    __select_impl(__mask, __v, _TV(_LoadCtorTag(), __ptr))._M_store(__ptr);
+	    return;
+	  }
+#endif
       if consteval
 	{
 	  for (int __i = 0; __i < _TV::size(); ++__i)
@@ -396,6 +456,320 @@ namespace simd
     partial_store(const basic_vec<_Tp, _Ap>& __v, _It __first, _Sp __last,
 		  const typename basic_vec<_Tp, _Ap>::mask_type& __mask, flags<_Flags...> __f = {})
     { partial_store(__v, span(__first, __last), __mask, __f); }
+
+  // [simd.permute.memory] ------------------------------------------------------
+  template <typename _Vp, typename _Tp, __simd_size_type _Np>
+    struct __gather_return
+    { using type = _Vp; };
+
+  template <typename _Tp, __simd_size_type _Np>
+    struct __gather_return<void, _Tp, _Np>
+    { using type = vec<_Tp, _Np>; };
+
+  template <typename _Vp, typename _Tp, __simd_size_type _Np>
+    using __gather_return_t = typename __gather_return<_Vp, _Tp, _Np>::type;
+
+  /** @internal
+   * Returns which elements of @p __idx are valid indices into a range of size @p __n.
+   */
+  template <__simd_integral _IV>
+    [[__gnu__::__always_inline__]]
+    constexpr typename _IV::mask_type
+    __indices_in_bounds(const _IV& __idx, size_t __n)
+    {
+      using _Ip = typename _IV::value_type;
+      using _Up = make_unsigned_t<_Ip>;
+      using _Mp = typename _IV::mask_type;
+      if (__n > size_t(numeric_limits<_Ip>::max()))
+	{
+	  if constexpr (is_signed_v<_Ip>)
+	    return __idx >= _Ip();
+	  else
+	    return _Mp(true);
+	}
+      else // negative indices turn into large unsigned values
+	return static_cast<_Mp>(rebind_t<_Up, _IV>(__idx) < _Up(__n));
+    }
+
+  /** @internal
+   * Gathers @p __ptr[@p __idx[i]] into _RV where @p __k is set.
+   */
+  template <typename _RV, typename _Tp, typename _IV>
+    [[__gnu__::__always_inline__]]
+    constexpr _RV
+    __gather_impl(const _Tp* __ptr, const typename _RV::mask_type& __k, const _IV& __idx)
+    {
+      using _Rp = typename _RV::value_type;
+      if constexpr (!__complex_like<_Rp>)
+	if !consteval
+	  {
+	    return _RV::_S_gather(__ptr, __idx, __k);
+	  }
+      return _RV([&](int __i) -> _Rp {
+	       if (!__k[__i])
+		 return _Rp();
+	       else if constexpr (__complex_like<_Rp> && !__complex_like<_Tp>)
+		 return static_cast<typename _Rp::value_type>(__ptr[__idx[__i]]);
+	       else
+		 return static_cast<_Rp>(__ptr[__idx[__i]]);
+	     });
+    }
+
+  /** @brief Returns the elements of @p __in at the indices @p __idx where @p __mask is set.
+   *
+   * Elements where @p __mask is not set are value-initialized. With AVX2 and AVX-512, 4- and
+   * 8-byte elements are read with a single (masked) vgather instruction per register; otherwise
+   * the elements are loaded one by one.
+   *
+   * @pre All indices where @p __mask is set are in the range [0, ranges::size(__in)).
+   */
+  template <typename _Vp = void, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    [[__gnu__::__always_inline__]]
+    constexpr __gather_return_t<_Vp, ranges::range_value_t<_Rg>, _IV::size()>
+    unchecked_gather_from(_Rg&& __in, const typename _IV::mask_type& __mask, const _IV& __idx,
+			  flags<_Flags...> = {})
+    {
+      using _Tp = ranges::range_value_t<_Rg>;
+      using _RV = __gather_return_t<_Vp, _Tp, _IV::size()>;
+      static_assert(__vectorizable<_Tp>);
+      static_assert(_RV::size() == _IV::size(),
+		    "the number of indices must match the size of the return type");
+      static_assert(__loadstore_convertible_to<_Tp, typename _RV::value_type, _Flags...>,
+		    "'flag_convert' must be used for conversions that are not value-preserving");
+      __glibcxx_simd_precondition(
+	(!__mask || __indices_in_bounds(__idx, ranges::size(__in)))._M_all_of(),
+	"a gather index is out of bounds. Did you mean to use 'partial_gather_from'?");
+      return __gather_impl<_RV>(ranges::data(__in), typename _RV::mask_type(__mask), __idx);
+    }
+
+  template <typename _Vp = void, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    [[__gnu__::__always_inline__]]
+    constexpr __gather_return_t<_Vp, ranges::range_value_t<_Rg>, _IV::size()>
+    unchecked_gather_from(_Rg&& __in, const _IV& __idx, flags<_Flags...> __f = {})
+    {
+      return simd::unchecked_gather_from<_Vp>(__in, typename _IV::mask_type(true), __idx,
+					      __f);
+    }
+
+  /** @brief Same as unchecked_gather_from, except that elements at out-of-bounds indices are
+   * value-initialized instead of read.
+   */
+  template <typename _Vp = void, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    [[__gnu__::__always_inline__]]
+    constexpr __gather_return_t<_Vp, ranges::range_value_t<_Rg>, _IV::size()>
+    partial_gather_from(_Rg&& __in, const typename _IV::mask_type& __mask, const _IV& __idx,
+			flags<_Flags...> __f = {})
+    {
+      return simd::unchecked_gather_from<_Vp>(
+	       __in, __mask && __indices_in_bounds(__idx, ranges::size(__in)), __idx, __f);
+    }
+
+  template <typename _Vp = void, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    [[__gnu__::__always_inline__]]
+    constexpr __gather_return_t<_Vp, ranges::range_value_t<_Rg>, _IV::size()>
+    partial_gather_from(_Rg&& __in, const _IV& __idx, flags<_Flags...> __f = {})
+    {
+      return simd::unchecked_gather_from<_Vp>(
+	       __in, __indices_in_bounds(__idx, ranges::size(__in)), __idx, __f);
+    }
+
+  /** @brief Stores the elements of @p __v where @p __mask is set to @p __out at the indices
+   * @p __idx.
+   *
+   * With AVX-512, 4- and 8-byte elements are written with a single (masked) vscatter instruction
+   * per register; otherwise the elements are stored one by one. If several elements have the same
+   * index, the last one (the highest element of @p __v) is stored.
+   *
+   * @pre All indices where @p __mask is set are in the range [0, ranges::size(__out)).
+   */
+  template <__simd_vec_type _Vp, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    requires (_Vp::size() == _IV::size())
+	       && indirectly_writable<ranges::iterator_t<_Rg>, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    unchecked_scatter_to(const _Vp& __v, _Rg&& __out, const typename _IV::mask_type& __mask,
+			 const _IV& __idx, flags<_Flags...> = {})
+    {
+      using _Tp = typename _Vp::value_type;
+      using _Up = ranges::range_value_t<_Rg>;
+      static_assert(__loadstore_convertible_to<_Tp, _Up, _Flags...>,
+		    "'flag_convert' must be used for conversions that are not value-preserving");
+      __glibcxx_simd_precondition(
+	(!__mask || __indices_in_bounds(__idx, ranges::size(__out)))._M_all_of(),
+	"a scatter index is out of bounds. Did you mean to use 'partial_scatter_to'?");
+      _Up* __ptr = ranges::data(__out);
+      const typename _Vp::mask_type __k(__mask);
+      if constexpr (!__complex_like<_Tp>)
+	if !consteval
+	  {
+	    _Vp::_S_scatter(__v, __ptr, __idx, __k);
+	    return;
+	  }
+      for (int __i = 0; __i < _Vp::size(); ++__i)
+	if (__k[__i])
+	  __ptr[__idx[__i]] = static_cast<_Up>(__v[__i]);
+    }
+
+  template <__simd_vec_type _Vp, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    requires (_Vp::size() == _IV::size())
+	       && indirectly_writable<ranges::iterator_t<_Rg>, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    unchecked_scatter_to(const _Vp& __v, _Rg&& __out, const _IV& __idx,
+			 flags<_Flags...> __f = {})
+    { simd::unchecked_scatter_to(__v, __out, typename _IV::mask_type(true), __idx, __f); }
+
+  /** @brief Same as unchecked_scatter_to, except that elements at out-of-bounds indices are not
+   * stored.
+   */
+  template <__simd_vec_type _Vp, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    requires (_Vp::size() == _IV::size())
+	       && indirectly_writable<ranges::iterator_t<_Rg>, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    partial_scatter_to(const _Vp& __v, _Rg&& __out, const typename _IV::mask_type& __mask,
+		       const _IV& __idx, flags<_Flags...> __f = {})
+    {
+      simd::unchecked_scatter_to(__v, __out,
+				 __mask && __indices_in_bounds(__idx, ranges::size(__out)), __idx,
+				 __f);
+    }
+
+  template <__simd_vec_type _Vp, __sized_contiguous_range _Rg, __simd_integral _IV,
+	    typename... _Flags>
+    requires (_Vp::size() == _IV::size())
+	       && indirectly_writable<ranges::iterator_t<_Rg>, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    partial_scatter_to(const _Vp& __v, _Rg&& __out, const _IV& __idx, flags<_Flags...> __f = {})
+    {
+      simd::unchecked_scatter_to(__v, __out, __indices_in_bounds(__idx, ranges::size(__out)),
+				 __idx, __f);
+    }
+
+#if VIR_EXTENSIONS
+  // Prefetch (extension) ---------------------------------------------------------
+  /** @brief Prefetches the elements of @p __r at the index @p __idx, or at all indices in
+   * @p __idx if it is a vec.
+   *
+   * Call this with the indices of a future iteration to hide the memory latency of gathers and
+   * scatters (e.g. @c prefetch(table, idx[i + 8]) before @c unchecked_gather_from(table,
+   * idx[i])). @p _Write requests the cache lines with intent to write (prefetchw, if enabled via
+   * -mprfchw). Indices out of bounds are no error, since prefetches never fault.
+   */
+  template <prefetch_hint _Hint = prefetch_hint::t0, bool _Write = false,
+	    __sized_contiguous_range _Rg, typename _IV>
+    requires __simd_integral<_IV> || integral<_IV>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    prefetch(_Rg&& __r, const _IV& __idx)
+    {
+      using _Up = ranges::range_value_t<_Rg>;
+      if !consteval
+	{
+	  const auto __addr = reinterpret_cast<__UINTPTR_TYPE__>(ranges::data(__r));
+	  if constexpr (integral<_IV>)
+	    __prefetch_bytes<_Hint, _Write, sizeof(_Up), alignof(_Up)>(
+	      __addr + __idx * sizeof(_Up));
+	  else
+	    for (int __i = 0; __i < _IV::size(); ++__i)
+	      __prefetch_bytes<_Hint, _Write, sizeof(_Up), alignof(_Up)>(
+		__addr + __idx[__i] * sizeof(_Up));
+	}
+    }
+
+  /** @brief Orders all preceding stores, including non-temporal stores via __flag_streaming,
+   * before all subsequent stores.
+   *
+   * Non-temporal stores are weakly ordered. Call this after a streaming write loop and before
+   * publishing the data to other threads (e.g. before a release store or unlocking a mutex).
+   */
+  [[__gnu__::__always_inline__]]
+  inline void
+  __streaming_fence() noexcept
+  {
+#if _GLIBCXX_X86
+    __builtin_ia32_sfence();
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+  }
+
+  // Compress store (extension) ------------------------------------------------
+  /** @brief Stores the elements of @p __v where @p __mask is set contiguously to @p __first and
+   * returns the iterator past the last stored element (stream compaction).
+   *
+   * Exactly reduce_count(@p __mask) elements are written. With AVX-512 this is a single
+   * vcompress instruction with memory operand (AVX512VBMI2 for 1- and 2-byte elements);
+   * otherwise the compressed vector is written with a partial store.
+   *
+   * @pre [@p __first, @p __first + reduce_count(@p __mask)) is a valid range.
+   */
+  template <__simd_vec_type _Vp, contiguous_iterator _It, typename... _Flags>
+    requires (!__complex_like<typename _Vp::value_type>)
+	       && indirectly_writable<_It, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr _It
+    compress_store(const _Vp& __v, const typename _Vp::mask_type& __mask, _It __first,
+		   flags<_Flags...> = {})
+    {
+      using _Up = iter_value_t<_It>;
+      static_assert(__loadstore_convertible_to<typename _Vp::value_type, _Up, _Flags...>,
+		    "'flag_convert' must be used for conversions that are not value-preserving");
+      if consteval
+	{
+	  for (int __i = 0; __i < _Vp::size(); ++__i)
+	    if (__mask[__i])
+	      *__first++ = static_cast<_Up>(__v[__i]);
+	  return __first;
+	}
+      else
+	return __first + _Vp::_S_compress_store(__v, std::to_address(__first), __mask, false);
+    }
+
+  /** @brief Same as above, but [@p __first, @p __last) is the remaining output buffer.
+   *
+   * As long as the buffer has room for @p __v::size() elements, the compressed vector is written
+   * with a full store (elements after the returned iterator are overwritten with unspecified
+   * values), which is cheaper than a partial store without AVX-512. Padding the output buffer by
+   * one vector thus makes every store of a compaction loop a full store.
+   *
+   * @pre reduce_count(@p __mask) <= @p __last - @p __first.
+   */
+  template <__simd_vec_type _Vp, contiguous_iterator _It, sized_sentinel_for<_It> _Sp,
+	    typename... _Flags>
+    requires (!__complex_like<typename _Vp::value_type>)
+	       && indirectly_writable<_It, typename _Vp::value_type>
+    [[__gnu__::__always_inline__]]
+    constexpr _It
+    compress_store(const _Vp& __v, const typename _Vp::mask_type& __mask, _It __first,
+		   _Sp __last, flags<_Flags...> __f = {})
+    {
+      const auto __room = __last - __first;
+      __glibcxx_simd_precondition(__room >= __mask._M_reduce_count(),
+				  "output range is too small for the selected elements");
+      if consteval
+	{
+	  return simd::compress_store(__v, __mask, __first, __f);
+	}
+      else
+	{
+	  using _Up = iter_value_t<_It>;
+	  static_assert(__loadstore_convertible_to<typename _Vp::value_type, _Up, _Flags...>,
+			"'flag_convert' must be used for conversions that are not "
+			"value-preserving");
+	  return __first + _Vp::_S_compress_store(__v, std::to_address(__first), __mask,
+						  __room >= _Vp::size());
+	}
+    }
+#endif // VIR_EXTENSIONS
 } // namespace simd
 _GLIBCXX_END_NAMESPACE_VERSION
 } // namespace std
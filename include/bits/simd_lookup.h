@@ -0,0 +1,152 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef _GLIBCXX_SIMD_LOOKUP_H
+#define _GLIBCXX_SIMD_LOOKUP_H 1
+
+#ifdef _GLIBCXX_SYSHDR
+#pragma GCC system_header
+#endif
+
+#if __cplusplus >= 202400L
+
+#include "simd_loadstore.h"
+
+// psabi warnings are bogus because the ABI of the internal types never leaks into user code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#if VIR_EXTENSIONS && VIR_PATCH_PERMUTE_DYNAMIC
+// Table lookup in registers (extension) -------------------------------------
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace simd
+{
+  /** @internal
+   * Tables up to this many registers are loaded into registers and indexed with permutes. Larger
+   * tables are gathered from memory.
+   */
+  inline constexpr int __lookup_max_registers = 4;
+
+  /** @internal
+   * True if a lookup into the concatenation of two @p _TV is a single instruction (vpermt2*).
+   */
+  template <typename _TV, _ArchTraits _Traits = {}>
+    consteval bool
+    __have_permute2()
+    {
+#if _GLIBCXX_X86
+      constexpr size_t __elsize = sizeof(__vec_value_type<_TV>);
+      if (!_Traits._M_have_avx512f() || sizeof(_TV) < 16
+	    || (sizeof(_TV) < 64 && !_Traits._M_have_avx512vl()))
+	return false;
+      else
+	return __elsize >= 4 || (__elsize == 2 && _Traits._M_have_avx512bw())
+		 || (__elsize == 1 && _Traits._M_have_avx512vbmi());
+#else
+      return false;
+#endif
+    }
+
+  /** @internal
+   * @brief Returns @p __table[@p __idx] with the result type @p _Rp.
+   *
+   * Two-register tables use vpermt2* if available. Everything else uses the dynamic permute
+   * (vpermps, vpermb, pshufb, ...), which splits multi-register tables in halves and blends the
+   * results.
+   */
+  template <typename _Rp, typename _Tp, typename _A0, typename _IV>
+    [[__gnu__::__always_inline__]]
+    constexpr _Rp
+    __lookup_regs(const basic_vec<_Tp, _A0>& __table, const _IV& __idx)
+    {
+      if constexpr (_A0::_S_nreg == 1)
+	return _Rp::_S_dynamic_permute(__table, __idx);
+      else
+	{
+	  using _T0 = remove_cvref_t<decltype(__table._M_get_low())>;
+	  using _T1 = remove_cvref_t<decltype(__table._M_get_high())>;
+	  using _TV = remove_cvref_t<decltype(declval<const _T0&>()._M_get())>;
+	  if constexpr (_Rp::abi_type::_S_nreg > 1)
+	    { // one lookup per result register
+	      using _R0 = remove_cvref_t<decltype(declval<const _Rp&>()._M_get_low())>;
+	      using _R1 = remove_cvref_t<decltype(declval<const _Rp&>()._M_get_high())>;
+	      const auto [__i0, __i1] = chunk<_R0::size()>(__idx);
+	      return _Rp::_S_init(__lookup_regs<_R0>(__table, __i0),
+				  __lookup_regs<_R1>(__table, __i1));
+	    }
+	  else if constexpr (_A0::_S_nreg == 2 && is_same_v<_T0, _T1> && _Rp::size() == _T0::size()
+			       && __have_permute2<_TV>())
+	    {
+	      using _UV = rebind_t<_UInt<sizeof(_Tp)>, _Rp>;
+	      return __builtin_shuffle(__table._M_get_low()._M_get(),
+				       __table._M_get_high()._M_get(), _UV(__idx)._M_get());
+	    }
+	  else
+	    return _Rp::_S_dynamic_permute(__table, __idx);
+	}
+    }
+
+  /** @brief Returns the elements of @p __table at the indices @p __idx.
+   *
+   * The table stays in registers. Compared to the dynamic permute (@c __table[__idx]), tables that
+   * span two registers are looked up with a single vpermt2* instruction with AVX-512 (vpermt2b for
+   * 8-bit elements requires AVX512VBMI).
+   *
+   * @pre All indices are in the range [0, __table.size()).
+   */
+  template <typename _Tp, typename _A0, __simd_integral _IV>
+    requires (!__complex_like<_Tp>)
+    [[__gnu__::__always_inline__]]
+    constexpr resize_t<_IV::size(), basic_vec<_Tp, _A0>>
+    lookup(const basic_vec<_Tp, _A0>& __table, const _IV& __idx)
+    {
+      using _Rp = resize_t<_IV::size(), basic_vec<_Tp, _A0>>;
+      constexpr int __max_index = _A0::_S_size - 1;
+      if constexpr (is_unsigned_v<typename _IV::value_type>)
+	__glibcxx_simd_precondition((__idx <= __max_index)._M_all_of(),
+				    "a lookup index is out of bounds");
+      else
+	__glibcxx_simd_precondition((__idx >= 0 && __idx <= __max_index)._M_all_of(),
+				    "a lookup index is out of bounds");
+      if (__is_const_known(__table, __idx))
+	return _Rp([&] [[__gnu__::__always_inline__]] (int __i) { return __table[__idx[__i]]; });
+      else
+	return __lookup_regs<_Rp>(__table, __idx);
+    }
+
+  /** @brief Returns the elements of the contiguous range @p __table at the indices @p __idx.
+   *
+   * If the size of @p __table is known at compile time and it fits into __lookup_max_registers
+   * registers (e.g. 64 floats with AVX-512, 32 floats with AVX), it is loaded into registers and
+   * looked up as above. Loop-invariant tables are thus only loaded once. Otherwise the elements are
+   * gathered from memory (see unchecked_gather_from).
+   *
+   * @pre All indices are in the range [0, ranges::size(__table)).
+   */
+  template <__sized_contiguous_range _Rg, __simd_integral _IV>
+    requires __vectorizable<ranges::range_value_t<_Rg>>
+	       && (!__complex_like<ranges::range_value_t<_Rg>>)
+    [[__gnu__::__always_inline__]]
+    constexpr resize_t<_IV::size(), vec<ranges::range_value_t<_Rg>>>
+    lookup(_Rg&& __table, const _IV& __idx)
+    {
+      using _Tp = ranges::range_value_t<_Rg>;
+      using _Rp = resize_t<_IV::size(), vec<_Tp>>;
+      constexpr size_t __n = __static_range_size(__table);
+      if constexpr (__n != dynamic_extent && __n <= __lookup_max_registers * vec<_Tp>::size())
+	return lookup(unchecked_load<vec<_Tp, __n>>(__table), __idx);
+      else
+	return unchecked_gather_from<_Rp>(__table, __idx);
+    }
+} // namespace simd
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+#endif // VIR_EXTENSIONS && VIR_PATCH_PERMUTE_DYNAMIC
+
+#pragma GCC diagnostic pop
+#endif // C++26
+#endif // _GLIBCXX_SIMD_LOOKUP_H
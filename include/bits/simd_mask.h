@@ -160,6 +160,89 @@ namespace simd
     { return __v[__indices]; }
 #endif
 
+  // [simd.permute.mask]
+  /** @brief Returns the elements of @p __v selected by @p __sel, packed to the front.
+   *
+   * The values of the remaining elements are unspecified, unless a fill value is given.
+   */
+  template<__simd_vec_type _Vp>
+    requires (!__complex_like<typename _Vp::value_type>)
+    [[__gnu__::__always_inline__]]
+    constexpr _Vp
+    compress(const _Vp& __v, const typename _Vp::mask_type& __sel)
+    { return _Vp::_S_compress(__v, __sel); }
+
+  template<__simd_vec_type _Vp>
+    requires (!__complex_like<typename _Vp::value_type>)
+    [[__gnu__::__always_inline__]]
+    constexpr _Vp
+    compress(const _Vp& __v, const typename _Vp::mask_type& __sel,
+	     const typename _Vp::value_type& __fill_value)
+    { return _Vp::_S_compress(__v, __sel, _Vp(__fill_value)); }
+
+  template<__simd_mask_type _Mp>
+    [[__gnu__::__always_inline__]]
+    constexpr _Mp
+    compress(const _Mp& __v, const type_identity_t<_Mp>& __sel)
+    {
+      if constexpr (_Mp::size() <= 64)
+	return _Mp(__bit_compress(__v.to_ullong(), __sel.to_ullong()));
+      else
+	{
+	  using _Vp = decltype(+__v);
+	  return _Mp(compress(+__v, typename _Vp::mask_type(__sel)) != 0);
+	}
+    }
+
+  template<__simd_mask_type _Mp>
+    [[__gnu__::__always_inline__]]
+    constexpr _Mp
+    compress(const _Mp& __v, const type_identity_t<_Mp>& __sel, bool __fill_value)
+    {
+      if constexpr (_Mp::size() <= 64)
+	{
+	  const unsigned long long __sel_bits = __sel.to_ullong();
+	  unsigned long long __r = __bit_compress(__v.to_ullong(), __sel_bits);
+	  const int __n = __builtin_popcountll(__sel_bits);
+	  if (__fill_value && __n < 64)
+	    __r |= ~0ull << __n;
+	  return _Mp(__r);
+	}
+      else
+	{
+	  using _Vp = decltype(+__v);
+	  return _Mp(compress(+__v, typename _Vp::mask_type(__sel), __fill_value) != 0);
+	}
+    }
+
+  /** @brief Returns @p __original with the elements selected by @p __sel replaced by the leading
+   * elements of @p __v, in order.
+   */
+  template<__simd_vec_type _Vp>
+    requires (!__complex_like<typename _Vp::value_type>)
+    [[__gnu__::__always_inline__]]
+    constexpr _Vp
+    expand(const _Vp& __v, const typename _Vp::mask_type& __sel, const _Vp& __original = {})
+    { return _Vp::_S_expand(__v, __sel, __original); }
+
+  template<__simd_mask_type _Mp>
+    [[__gnu__::__always_inline__]]
+    constexpr _Mp
+    expand(const _Mp& __v, const type_identity_t<_Mp>& __sel, const _Mp& __original = {})
+    {
+      if constexpr (_Mp::size() <= 64)
+	{
+	  const unsigned long long __sel_bits = __sel.to_ullong();
+	  return _Mp(__bit_expand(__v.to_ullong(), __sel_bits)
+		       | (__original.to_ullong() & ~__sel_bits));
+	}
+      else
+	{
+	  using _Vp = decltype(+__v);
+	  return _Mp(expand(+__v, typename _Vp::mask_type(__sel), +__original) != 0);
+	}
+    }
+
   // [simd.creation] ----------------------------------------------------------
   template<__simd_vec_type _Vp, typename _Ap>
     [[__gnu__::__always_inline__]]
@@ -25,8 +25,57 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 namespace simd
 {
 #if VIR_PATCH_MATH
+  // With VIR_MATH_INLINE, math functions call the kernels in simd_math_kernels.h instead of the
+  // ones in libsimd.so (where available). The _Float16 kernels for AVX512FP16 are always inline.
+#ifndef VIR_MATH_INLINE
+#define VIR_MATH_INLINE 0
+#endif
+
+  /** @internal
+   * Returns the math ABI the VIR_MATH_DISPATCH entry points in libsimd resolve to on the executing
+   * CPU (0: v1, 1: v2, 2: v3a, 3: v3b, 4: v4).
+   */
+  int
+  __math_dispatch_level() noexcept;
+
+#if VIR_EXTENSIONS
+  /** @brief Accuracy policy for the math functions, passed as their first template argument.
+   *
+   * Requests results within @p _Ulp ULP, even with -ffast-math (e.g. @c hypot<math_precision<1>>(x,
+   * y) calls the precise kernel instead of the approximating one). Larger @p _Ulp allow kernels
+   * that are faster but less precise, never the -ffast-math kernels: float sqrt via rsqrt from
+   * 3 ULP, the _Float16 kernels within their bounds, and libmvec with VIR_LIBMVEC from 4 ULP.
+   *
+   * With AVX512FP16, exp, log, sin, cos, and tanh have native _Float16 kernels (twice the lanes of
+   * evaluating in float). exp is within 1 ULP and thus used by default. log, sin, and tanh need
+   * math_precision<2>, cos needs math_precision<4> (or -ffast-math). Otherwise, and for all other
+   * functions, _Float16 is evaluated in float. rsqrt always uses its _Float16 kernel.
+   *
+   * All other floating-point flags of the translation unit are kept. In particular, with
+   * -ffinite-math-only (implied by -ffast-math) the kernels still assume finite inputs and do not
+   * handle infinities and NaNs, and subnormals are flushed to zero if the program runs with FTZ/DAZ
+   * (as set up by linking with -ffast-math).
+   */
+  template <int _Ulp>
+    requires (_Ulp > 0)
+    inline constexpr _TargetTraits math_precision
+      = {_ArchTraits(),
+	 _OptTraits{(_OptTraits()._M_build_flags & ~(__UINT64_TYPE__(0xff) << 16 | 0b10))
+		      | __UINT64_TYPE__(_Ulp < 0xff ? _Ulp : 0xff) << 16}};
+
+  /** @brief Accuracy policy for the math functions, passed as their first template argument.
+   *
+   * Uses the fastest kernels and assumes the call would be compiled with -ffast-math (finite
+   * values, no signed zeros, no trapping, no errno).
+   */
+  inline constexpr _TargetTraits fast_math
+    = {_ArchTraits(),
+       _OptTraits{(_OptTraits()._M_build_flags & ~(__UINT64_TYPE__(0xff) << 16 | 0b1))
+		    | 0b1111110}};
+
+#endif
   template <typename _TV>
-    concept __simd_clonable = __vec_builtin<_TV> && sizeof(_TV) >= 16
+    concept __simd_clonable = __vec_builtin<_TV> && sizeof(_TV) >= 8
 				&& (is_same_v<__vec_value_type<_TV>, float>
 				      || is_same_v<__vec_value_type<_TV>, double>);
 
@@ -56,6 +105,145 @@ namespace simd
 #define _GLIBCXX_SIMD_HAS_SIMD_CLONE(fn)                                                           \
   __is_attribute_simd(_GLIBCXX_SIMD_TOSTRING(__SIMD_DECL(fn)))
 
+  // glibc declares the simd-clones only with __FAST_MATH__. With VIR_LIBMVEC, math functions call
+  // the libmvec entry points (_ZGV*) directly whenever _M_allows_ulp(4) holds (libmvec documents
+  // at most 4 ULP error). This requires linking with -lmvec (glibc 2.35 or later).
+#if VIR_LIBMVEC && _GLIBCXX_X86 && defined __x86_64__
+  /** @internal
+   * True if libmvec implements @p __fn for float and double.
+   */
+  consteval bool
+  __libmvec_provides(const char* __fn)
+  {
+    for (const char* __name : {"acos", "acosh", "asin", "asinh", "atan", "atanh", "cbrt", "cos",
+			       "cosh", "erf", "erfc", "exp", "exp2", "expm1", "log", "log10",
+			       "log1p", "log2", "sin", "sinh", "tan", "tanh", "atan2", "pow"})
+      if (__builtin_strcmp(__name, __fn) == 0)
+	return true;
+    return false;
+  }
+
+#define _GLIBCXX_SIMD_HAS_LIBMVEC(fn) __libmvec_provides(#fn)
+
+  template <int _Np>
+    using __libmvec_float_t = __vec_builtin_type<float, _Np>;
+
+  template <int _Np>
+    using __libmvec_double_t = __vec_builtin_type<double, _Np>;
+
+  // Declares the libmvec entry points of fn for one ISA (x86_64 vector function ABI):
+  // b: SSE, c: AVX, d: AVX2, e: AVX-512
+#define _GLIBCXX_SIMD_LIBMVEC_ENTRY(fn, isa, nf, nd, params, args)                                 \
+  [[__gnu__::__const__]] __libmvec_float_t<nf>                                                     \
+  __libmvec_##fn##_##isa(args(__libmvec_float_t<nf>)) noexcept                                     \
+  __asm__("_ZGV" #isa "N" #nf #params "_" #fn "f");                                                \
+												   \
+  [[__gnu__::__const__]] __libmvec_double_t<nd>                                                    \
+  __libmvec_##fn##_##isa(args(__libmvec_double_t<nd>)) noexcept                                    \
+  __asm__("_ZGV" #isa "N" #nd #params "_" #fn);
+
+#define _GLIBCXX_SIMD_LIBMVEC_1ARG(_Tp) _Tp
+#define _GLIBCXX_SIMD_LIBMVEC_2ARGS(_Tp) _Tp, _Tp
+
+#define _GLIBCXX_SIMD_LIBMVEC_ENTRIES(fn, params, args)                                            \
+  _GLIBCXX_SIMD_LIBMVEC_ENTRY(fn, b, 4, 2, params, args)                                           \
+  _GLIBCXX_SIMD_LIBMVEC_ENTRY(fn, c, 8, 4, params, args)                                           \
+  _GLIBCXX_SIMD_LIBMVEC_ENTRY(fn, d, 8, 4, params, args)                                           \
+  _GLIBCXX_SIMD_LIBMVEC_ENTRY(fn, e, 16, 8, params, args)
+
+  // __libmvec_fn calls the entry point for the widest ISA the target supports. It pads 8-byte
+  // vectors and splits vectors wider than the widest entry point.
+#define _GLIBCXX_SIMD_LIBMVEC(fn)                                                                  \
+  _GLIBCXX_SIMD_LIBMVEC_ENTRIES(fn, v, _GLIBCXX_SIMD_LIBMVEC_1ARG)                                 \
+												   \
+  template <_ArchTraits _Ap, __simd_clonable _TV>                                                  \
+    [[__gnu__::__always_inline__]]                                                                 \
+    inline _TV                                                                                     \
+    __libmvec_##fn(_TV __x) noexcept                                                               \
+    {                                                                                              \
+      if constexpr (sizeof(_TV) < 16)                                                              \
+	return __vec_split_lo(__libmvec_##fn<_Ap>(__vec_concat(__x, __x)));                        \
+      else if constexpr (sizeof(_TV) == 16)                                                        \
+	return __libmvec_##fn##_b(__x);                                                            \
+      else if constexpr (sizeof(_TV) == 32 && _Ap._M_have_avx2())                                  \
+	return __libmvec_##fn##_d(__x);                                                            \
+      else if constexpr (sizeof(_TV) == 32 && _Ap._M_have_avx())                                   \
+	return __libmvec_##fn##_c(__x);                                                            \
+      else if constexpr (sizeof(_TV) == 64 && _Ap._M_have_avx512f())                               \
+	return __libmvec_##fn##_e(__x);                                                            \
+      else                                                                                         \
+	return __vec_concat(__libmvec_##fn<_Ap>(__vec_split_lo(__x)),                              \
+			    __libmvec_##fn<_Ap>(__vec_split_hi(__x)));                             \
+    }
+
+#define _GLIBCXX_SIMD_LIBMVEC2(fn)                                                                 \
+  _GLIBCXX_SIMD_LIBMVEC_ENTRIES(fn, vv, _GLIBCXX_SIMD_LIBMVEC_2ARGS)                               \
+												   \
+  template <_ArchTraits _Ap, __simd_clonable _TV>                                                  \
+    [[__gnu__::__always_inline__]]                                                                 \
+    inline _TV                                                                                     \
+    __libmvec_##fn(_TV __x, _TV __y) noexcept                                                      \
+    {                                                                                              \
+      if constexpr (sizeof(_TV) < 16)                                                              \
+	return __vec_split_lo(__libmvec_##fn<_Ap>(__vec_concat(__x, __x),                          \
+						  __vec_concat(__y, __y)));                        \
+      else if constexpr (sizeof(_TV) == 16)                                                        \
+	return __libmvec_##fn##_b(__x, __y);                                                       \
+      else if constexpr (sizeof(_TV) == 32 && _Ap._M_have_avx2())                                  \
+	return __libmvec_##fn##_d(__x, __y);                                                       \
+      else if constexpr (sizeof(_TV) == 32 && _Ap._M_have_avx())                                   \
+	return __libmvec_##fn##_c(__x, __y);                                                       \
+      else if constexpr (sizeof(_TV) == 64 && _Ap._M_have_avx512f())                               \
+	return __libmvec_##fn##_e(__x, __y);                                                       \
+      else                                                                                         \
+	return __vec_concat(__libmvec_##fn<_Ap>(__vec_split_lo(__x), __vec_split_lo(__y)),         \
+			    __libmvec_##fn<_Ap>(__vec_split_hi(__x), __vec_split_hi(__y)));        \
+    }
+#else
+#define _GLIBCXX_SIMD_HAS_LIBMVEC(fn) false
+#define _GLIBCXX_SIMD_LIBMVEC(fn)
+#define _GLIBCXX_SIMD_LIBMVEC2(fn)
+#endif
+
+  // With AVX512FP16, some functions have _Float16 kernels in simd_math_kernels.h, which don't
+  // convert to float (and thus keep the lane count). They are only used if their error fits the
+  // ULP budget of _Traits; otherwise the function is evaluated in float.
+#if _GLIBCXX_X86
+  /** @internal
+   * The maximum error in ULP of the _Float16 kernel for @p __fn in simd_math_kernels.h, or 0 if
+   * there is none.
+   */
+  consteval int
+  __f16_kernel_max_ulp(const char* __fn)
+  {
+    constexpr pair<const char*, int> __kernels[]
+      = {{"exp", 1}, {"log", 2}, {"sin", 2}, {"cos", 4}, {"tanh", 2}};
+    for (auto [__name, __ulp] : __kernels)
+      if (__builtin_strcmp(__name, __fn) == 0)
+	return __ulp;
+    return 0;
+  }
+
+#define _GLIBCXX_SIMD_USE_F16_KERNEL(fn, _Vp, _Traits)                                             \
+  (__f16_kernel_max_ulp(#fn) > 0 && is_same_v<typename _Vp::value_type, _Float16>                  \
+     && _Traits._M_have_avx512fp16() && _Traits._M_allows_ulp(__f16_kernel_max_ulp(#fn)))
+#else
+#define _GLIBCXX_SIMD_USE_F16_KERNEL(fn, _Vp, _Traits) false
+#endif
+
+  /** @internal
+   * True if a single-register @p _Vp should call libmvec directly. This is the case if libmvec
+   * implements the function (@p __has_libmvec), but glibc doesn't declare a simd-clone for it
+   * (@p __has_clone), which would be used instead.
+   */
+  template <typename _Vp>
+    consteval bool
+    __use_libmvec(bool __has_libmvec, bool __has_clone)
+    {
+      return __has_libmvec && !__has_clone
+	       && __simd_clonable<remove_cvref_t<decltype(declval<const _Vp&>()._M_get())>>;
+    }
+
   // __FAST_MATH__ must be defined when including <math.h> in order to get calls to simd-clones of
   // the math functions. Therefore, with __FAST_MATH__ we can inline everything, without it we need
   // to call into the library, which can be compiled with fast-math.
@@ -69,16 +257,25 @@ namespace simd
   // some reason the body of __fast_fn does not compile to something GCC wants to inline, then the
   // gnu_inline attribute makes a call to the __fast_fn function in the library.
 
-#if _GLIBCXX_X86
-
-  // A pair<V0, V1> would always return via MEMORY, not SSE, according to the AMD64 psABI.
-  // However, in this case we *really* could use return via two registers: [xyz]mm0 and [xyz]mm1. It
-  // seems like we can do the trick via inline asm. It would be much better to have a different
-  // calling convention function attribute, though.
+  // Multiple results of math entry points (__2x_fn, __sincos, and __frexp and __remquo with an
+  // additional int vector).
+  //
+  // A pair<V0, V1> would always return via MEMORY, not SSE, according to the AMD64 psABI, and GCC
+  // has no calling convention attribute that returns several vectors in registers. However, in
+  // this case we *really* could use return via several registers: [xyz]mm0, [xyz]mm1, ... The
+  // callee therefore pins result i to vector register i via a hard register asm constraint and
+  // returns the first result normally. The caller reads the other results from the same registers
+  // in an asm statement immediately after the call. Register names for ymm/zmm are not needed: the
+  // mode of the operand determines the width.
   // (asm: it is important to fake a read-write to xmm0 in order to ensure no function gets called
   // without saving xmm1 to the stack - unless xmm1 is an argument to that function call)
   //
-  // with this hack (hypot2 benchmark on Intel(R) Core(TM) Ultra 7 165U):
+  // Both asm statements only work because __math_return and __math_call are always inlined
+  // directly at the return statement and the call, respectively. Other targets return nested
+  // pairs. The return type is part of the mangled name of the entry point templates. Therefore,
+  // callers and the library cannot silently disagree on the convention.
+  //
+  // returning in registers (hypot2 benchmark on Intel(R) Core(TM) Ultra 7 165U):
   //   TYPE                  Latency     Speedup     Throughput     Speedup
   //                   [cycles/call] [per value]  [cycles/call] [per value]
   //  float,                    56.2           1           11.9           1
@@ -95,7 +292,7 @@ namespace simd
   // double, 16                  100        15.6           91.9        3.13
   // double, 32                  190        16.4            188        3.05
   //
-  // without this hack:
+  // returning via memory:
   //  TYPE                   Latency     Speedup     Throughput     Speedup
   //                   [cycles/call] [per value]  [cycles/call] [per value]
   //  float,                    56.2           1           11.9           1
@@ -117,49 +314,121 @@ namespace simd
   // Throughput is only due to the library function having to store to memory rather than returning
   // in registers.
 
-#define _GLIBCXX_SIMD_MATH_2X_CALL(fn, arg)                                                        \
-  remove_cvref_t<decltype(arg._M_get_high()._M_get())> __hi;                                       \
-  auto __lo = fn(arg._M_get_low()._M_get(), arg._M_get_high()._M_get());                           \
-  asm("" : "={xmm1}"(__hi), "+{xmm0}"(__lo))
-
-#define _GLIBCXX_SIMD_MATH_2X_CALL2(fn, arg0, arg1)                                                \
-  remove_cvref_t<decltype(arg0._M_get_high()._M_get())> __hi;                                      \
-  auto __lo = fn(arg0._M_get_low()._M_get(), arg1._M_get_low()._M_get(),                           \
-		 arg0._M_get_high()._M_get(), arg1._M_get_high()._M_get());                        \
-  asm("" : "={xmm1}"(__hi), "+{xmm0}"(__lo))
-
-#define _GLIBCXX_SIMD_MATH_2X_CALL3(fn, arg0, arg1, arg2)                                          \
-  remove_cvref_t<decltype(arg0._M_get_high()._M_get())> __hi;                                      \
-  auto __lo = fn(arg0._M_get_low()._M_get(), arg1._M_get_low()._M_get(),                           \
-		 arg2._M_get_low()._M_get(), arg0._M_get_high()._M_get(),                          \
-		 arg1._M_get_high()._M_get(), arg2._M_get_high()._M_get());                        \
-  asm("" : "={xmm1}"(__hi), "+{xmm0}"(__lo))
-
-#define _GLIBCXX_SIMD_MATH_RET_TYPE(V0, V1) V0
-
-#define _GLIBCXX_SIMD_MATH_RETURN(lo, hi)                                                          \
-  asm("" :: "{xmm1}"(hi), "{xmm0}"(lo));                                                           \
-  return lo
-
+#if _GLIBCXX_X86
+#define _GLIBCXX_SIMD_MATH_RESULTS_IN_REGS 1
 #else
+#define _GLIBCXX_SIMD_MATH_RESULTS_IN_REGS 0
+#endif
 
-#define _GLIBCXX_SIMD_MATH_2X_CALL(fn, arg)                                                        \
-  const auto [__lo, __hi] = fn(arg._M_get_low()._M_get(), arg._M_get_high()._M_get())
+  /** @internal
+   * The return type of a math entry point with the results @p _V0, @p _Vs...
+   */
+  template <typename _V0, typename... _Vs>
+    struct __math_results
+    {
+#if _GLIBCXX_SIMD_MATH_RESULTS_IN_REGS
+      using type = _V0;
+#else
+      using type = pair<_V0, typename __math_results<_Vs...>::type>;
+#endif
+    };
 
-#define _GLIBCXX_SIMD_MATH_2X_CALL2(fn, arg0, arg1)                                                \
-  const auto [__lo, __hi] = fn(arg0._M_get_low()._M_get(), arg1._M_get_low()._M_get(),             \
-			       arg0._M_get_high()._M_get(), arg1._M_get_high()._M_get())
+  template <typename _V0>
+    struct __math_results<_V0>
+    { using type = _V0; };
 
-#define _GLIBCXX_SIMD_MATH_2X_CALL3(fn, arg0, arg1, arg2)                                          \
-  const auto [__lo, __hi] = fn(arg0._M_get_low()._M_get(), arg1._M_get_low()._M_get(),             \
-			       arg2._M_get_low()._M_get(), arg0._M_get_high()._M_get(),            \
-			       arg1._M_get_high()._M_get(), arg2._M_get_high()._M_get())
+  template <typename _V0, typename... _Vs>
+    using __math_results_t = typename __math_results<_V0, _Vs...>::type;
 
-#define _GLIBCXX_SIMD_MATH_RET_TYPE(V0, V1) pair<V0, V1>
+  /** @internal
+   * Returns @p __r0, @p __rs... from a math entry point. Use as `return __math_return(...)`.
+   */
+  template <typename _V0, typename... _Vs>
+    [[__gnu__::__always_inline__]]
+    inline __math_results_t<_V0, _Vs...>
+    __math_return(_V0 __r0, _Vs... __rs)
+    {
+      static_assert(sizeof...(_Vs) <= 2, "at most three results are supported");
+#if _GLIBCXX_SIMD_MATH_RESULTS_IN_REGS
+      if constexpr (sizeof...(_Vs) == 1)
+	asm("" :: "{xmm1}"(__rs...[0]), "{xmm0}"(__r0));
+      else if constexpr (sizeof...(_Vs) == 2)
+	asm("" :: "{xmm1}"(__rs...[0]), "{xmm2}"(__rs...[1]), "{xmm0}"(__r0));
+      return __r0;
+#else
+      if constexpr (sizeof...(_Vs) == 0)
+	return __r0;
+      else
+	return {__r0, __math_return(__rs...)};
+#endif
+    }
 
-#define _GLIBCXX_SIMD_MATH_RETURN(lo, hi) return pair(lo, hi)
+#if !_GLIBCXX_SIMD_MATH_RESULTS_IN_REGS
+  template <typename _Rp, typename _Gp, typename... _Done>
+    [[__gnu__::__always_inline__]]
+    inline auto
+    __math_unpack(const _Rp& __r, _Gp& __consume, const _Done&... __done)
+    {
+      if constexpr (requires { __r.second; })
+	return __math_unpack(__r.second, __consume, __done..., __r.first);
+      else
+	return __consume(__done..., __r);
+    }
+#endif
 
+  /** @internal
+   * Calls the math entry point via @p __call and passes its results (of types @p _V0, @p _Vs...)
+   * to @p __consume. Returns what @p __consume returns.
+   */
+  template <typename _V0, typename... _Vs, typename _Fp, typename _Gp>
+    [[__gnu__::__always_inline__]]
+    inline auto
+    __math_call(_Fp&& __call, _Gp&& __consume)
+    {
+      static_assert(sizeof...(_Vs) <= 2, "at most three results are supported");
+#if _GLIBCXX_SIMD_MATH_RESULTS_IN_REGS
+      if constexpr (sizeof...(_Vs) == 0)
+	return __consume(__call());
+      else if constexpr (sizeof...(_Vs) == 1)
+	{
+	  _Vs...[0] __r1;
+	  _V0 __r0 = __call();
+	  asm("" : "={xmm1}"(__r1), "+{xmm0}"(__r0));
+	  return __consume(__r0, __r1);
+	}
+      else
+	{
+	  _Vs...[0] __r1;
+	  _Vs...[1] __r2;
+	  _V0 __r0 = __call();
+	  asm("" : "={xmm1}"(__r1), "={xmm2}"(__r2), "+{xmm0}"(__r0));
+	  return __consume(__r0, __r1, __r2);
+	}
+#else
+      const __math_results_t<_V0, _Vs...> __r = __call();
+      return __math_unpack(__r, __consume);
 #endif
+    }
+
+  /** @internal
+   * Calls the __2x_ entry point @p __fn with the low halves of @p __args followed by their high
+   * halves and returns the concatenated results.
+   */
+  template <typename _Vp, typename _Fp, same_as<_Vp>... _Args>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __math_call_2x(_Fp&& __fn, const _Args&... __args)
+    {
+      using _V0 = remove_cvref_t<decltype(declval<const _Vp&>()._M_get_low()._M_get())>;
+      using _V1 = remove_cvref_t<decltype(declval<const _Vp&>()._M_get_high()._M_get())>;
+      return __math_call<_V0, _V1>(
+	       [&] [[__gnu__::__always_inline__]] {
+		 return __fn(__args._M_get_low()._M_get()..., __args._M_get_high()._M_get()...);
+	       },
+	       [] [[__gnu__::__always_inline__]] (const _V0& __lo, const _V1& __hi) {
+		 return _Vp::_S_init(__lo, __hi);
+	       });
+    }
 
 #define _GLIBCXX_SIMD_MATH_2ARG_OVERLOADS(decl, fn)                                                \
   template<_TargetTraits _Traits = {}, __math_floating_point _Vp>                                  \
@@ -219,14 +488,21 @@ namespace simd
     }
 
 #define _GLIBCXX_SIMD_MATH_CALL(fn)                                                                \
-  template <_ArchTraits, __simd_clonable _TV>                                                      \
+  _GLIBCXX_SIMD_LIBMVEC(fn)                                                                        \
+												   \
+  template <_ArchTraits _Ap, __simd_clonable _TV>                                                  \
     requires (_GLIBCXX_SIMD_HAS_SIMD_CLONE(fn))                                                    \
     [[__gnu__::__gnu_inline__]]                                                                    \
     inline _TV                                                                                     \
     __fast_##fn(_TV __x)                                                                           \
     {                                                                                              \
-      constexpr auto [...__is] = _IotaArray<__width_of<_TV>>;                                      \
-      return _TV{std::fn(__x[__is])...};                                                           \
+      if constexpr (sizeof(_TV) < 16) /* there are no 8-byte clones */                             \
+	return __vec_split_lo(__fast_##fn<_Ap>(__vec_concat(__x, __x)));                           \
+      else                                                                                         \
+	{                                                                                          \
+	  constexpr auto [...__is] = _IotaArray<__width_of<_TV>>;                                  \
+	  return _TV{std::fn(__x[__is])...};                                                       \
+	}                                                                                          \
     }                                                                                              \
 												   \
   template <_ArchTraits, typename _Vp>                                                             \
@@ -235,7 +511,7 @@ namespace simd
     __fast_##fn(_Vp);                                                                              \
 												   \
   template <_ArchTraits, typename _V0, typename _V1>                                               \
-    extern _GLIBCXX_SIMD_MATH_RET_TYPE(_V0, _V1)                                                   \
+    extern __math_results_t<_V0, _V1>                                                              \
     __fast_2x_##fn(_V0, _V1);                                                                      \
 												   \
   template <_TargetTraits, typename _Vp>                                                           \
@@ -243,7 +519,7 @@ namespace simd
     __##fn(_Vp);                                                                                   \
 												   \
   template <_TargetTraits, typename _V0, typename _V1>                                             \
-    extern _GLIBCXX_SIMD_MATH_RET_TYPE(_V0, _V1)                                                   \
+    extern __math_results_t<_V0, _V1>                                                              \
     __2x_##fn(_V0, _V1);                                                                           \
 												   \
   template<_TargetTraits _Traits = {}, __math_floating_point _Vp>                                  \
@@ -259,54 +535,67 @@ namespace simd
 	       });                                                                                 \
       else if constexpr (_Vp::size() == 1)                                                         \
 	return std::fn(__x[0]);                                                                    \
-      else if constexpr (_Traits.template _M_eval_as_f32<typename _Vp::value_type>())              \
+      else if constexpr (_GLIBCXX_SIMD_USE_F16_KERNEL(fn, _Vp, _Traits))                           \
+	return __f16_##fn##_kernel<_Traits>(__x);                                                  \
+      else if constexpr (_Traits.template _M_eval_as_f32<typename _Vp::value_type>()              \
+			   || is_same_v<typename _Vp::value_type, _Float16>)                       \
+	/* libsimd has no _Float16 entry points for unary functions */                             \
 	return _Vp(fn<_Traits, rebind_t<float, _Vp>>(__x));                                        \
-      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_fast_math())                    \
+      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_allows_ulp(4)                   \
+			   && __use_libmvec<_Vp>(_GLIBCXX_SIMD_HAS_LIBMVEC(fn),                    \
+						 _GLIBCXX_SIMD_HAS_SIMD_CLONE(fn)))                \
+	return __libmvec_##fn<_ArchTraits(_Traits)>(__x._M_get());                                 \
+      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_approx_math())                  \
 	return __fast_##fn<_ArchTraits(_Traits)._M_math_abi()>(__x._M_get());                      \
       else if constexpr (_Vp::abi_type::_S_nreg == 1)                                              \
 	return __##fn<_Traits._M_math_abi()>(__x._M_get());                                        \
-      else if constexpr (__can_dispatch_2x<_Vp>() && _Traits._M_fast_math()                        \
-			   && !_GLIBCXX_SIMD_HAS_SIMD_CLONE(fn))                                   \
-	{                                                                                          \
-	  _GLIBCXX_SIMD_MATH_2X_CALL(__fast_2x_##fn<_ArchTraits(_Traits)._M_math_abi()>, __x);     \
-	  return _Vp::_S_init(__lo, __hi);                                                         \
-	}                                                                                          \
-      else if constexpr (__can_dispatch_2x<_Vp>() && !_Traits._M_fast_math())                      \
-	{                                                                                          \
-	  _GLIBCXX_SIMD_MATH_2X_CALL(__2x_##fn<_Traits._M_math_abi()>, __x);                       \
-	  return _Vp::_S_init(__lo, __hi);                                                         \
-	}                                                                                          \
+      else if constexpr (__can_dispatch_2x<_Vp>() && _Traits._M_approx_math()                      \
+			   && !_GLIBCXX_SIMD_HAS_SIMD_CLONE(fn) && !_GLIBCXX_SIMD_HAS_LIBMVEC(fn)) \
+	return __math_call_2x<_Vp>([] [[__gnu__::__always_inline__]] (auto... __args) {            \
+				    return __fast_2x_##fn<_ArchTraits(_Traits)._M_math_abi()>(     \
+					     __args...);                                           \
+				  }, __x);                                                         \
+      else if constexpr (__can_dispatch_2x<_Vp>() && !_Traits._M_approx_math())                    \
+	return __math_call_2x<_Vp>([] [[__gnu__::__always_inline__]] (auto... __args) {            \
+				    return __2x_##fn<_Traits._M_math_abi()>(__args...);            \
+				  }, __x);                                                         \
       else                                                                                         \
-	return _Vp::_S_init(fn<_Traits>(__x._M_get_low()), fn(__x._M_get_high()));                 \
+	return _Vp::_S_init(fn<_Traits>(__x._M_get_low()), fn<_Traits>(__x._M_get_high()));        \
     }
 
 #if 1
 #define _GLIBCXX_SIMD_MATH_CALL2_HANDLE_2X(fn)                                                     \
-      else if constexpr (__can_dispatch_2x<_Vp>() && _Traits._M_fast_math()                        \
-			   && !_GLIBCXX_SIMD_HAS_SIMD_CLONE(fn))         \
-	{                                                                                          \
-	  _GLIBCXX_SIMD_MATH_2X_CALL2(__fast_2x_##fn<_ArchTraits(_Traits)._M_math_abi()>,          \
-				      __x, __y);                                                   \
-	  return _Vp::_S_init(__lo, __hi);                                                         \
-	}                                                                                          \
-      else if constexpr (__can_dispatch_2x<_Vp>() && !_Traits._M_fast_math())                      \
-	{                                                                                          \
-	  _GLIBCXX_SIMD_MATH_2X_CALL2(__2x_##fn<_Traits._M_math_abi()>, __x, __y);                 \
-	  return _Vp::_S_init(__lo, __hi);                                                         \
-	}
+      else if constexpr (__can_dispatch_2x<_Vp>() && _Traits._M_approx_math()                      \
+			   && !_GLIBCXX_SIMD_HAS_SIMD_CLONE(fn) && !_GLIBCXX_SIMD_HAS_LIBMVEC(fn)) \
+	return __math_call_2x<_Vp>([] [[__gnu__::__always_inline__]] (auto... __args) {            \
+				    return __fast_2x_##fn<_ArchTraits(_Traits)._M_math_abi()>(     \
+					     __args...);                                           \
+				  }, __x, __y);                                                    \
+      else if constexpr (__can_dispatch_2x<_Vp>() && !_Traits._M_approx_math())                    \
+	return __math_call_2x<_Vp>([] [[__gnu__::__always_inline__]] (auto... __args) {            \
+				    return __2x_##fn<_Traits._M_math_abi()>(__args...);            \
+				  }, __x, __y);
 #else
 #define _GLIBCXX_SIMD_MATH_CALL2_HANDLE_2X(fn)
 #endif
 
-#define _GLIBCXX_SIMD_MATH_CALL2(fn, allow_clone)                                                  \
-  template <_ArchTraits, __simd_clonable _TV>                                                      \
+#define _GLIBCXX_SIMD_MATH_CALL2(fn, allow_clone, inline_kernel)                                   \
+  _GLIBCXX_SIMD_LIBMVEC2(fn)                                                                       \
+												   \
+  template <_ArchTraits _Ap, __simd_clonable _TV>                                                  \
     requires (allow_clone && _GLIBCXX_SIMD_HAS_SIMD_CLONE(fn))                                     \
     [[__gnu__::__gnu_inline__]]                                                                    \
     inline _TV                                                                                     \
     __fast_##fn(_TV __x0, _TV __x1) noexcept                                                       \
     {                                                                                              \
-      constexpr auto [...__is] = _IotaArray<__width_of<_TV>>;                                      \
-      return _TV{std::fn(__x0[__is], __x1[__is])...};                                              \
+      if constexpr (sizeof(_TV) < 16) /* there are no 8-byte clones */                             \
+	return __vec_split_lo(__fast_##fn<_Ap>(__vec_concat(__x0, __x0),                           \
+					       __vec_concat(__x1, __x1)));                         \
+      else                                                                                         \
+	{                                                                                          \
+	  constexpr auto [...__is] = _IotaArray<__width_of<_TV>>;                                  \
+	  return _TV{std::fn(__x0[__is], __x1[__is])...};                                          \
+	}                                                                                          \
     }                                                                                              \
 												   \
   template <_ArchTraits, typename _TV>                                                             \
@@ -317,7 +606,7 @@ namespace simd
 												   \
   template <_ArchTraits, typename _V0, typename _V1>                                               \
     [[__gnu__::__const__]]                                                                         \
-    extern _GLIBCXX_SIMD_MATH_RET_TYPE(_V0, _V1)                                                   \
+    extern __math_results_t<_V0, _V1>                                                              \
     __fast_2x_##fn(_V0, _V0, _V1, _V1) noexcept;                                                   \
 												   \
   template <_TargetTraits, typename _TV>                                                           \
@@ -325,7 +614,7 @@ namespace simd
     __##fn(_TV, _TV) noexcept;                                                                     \
 												   \
   template <_TargetTraits, typename _V0, typename _V1>                                             \
-    _GLIBCXX_SIMD_MATH_RET_TYPE(_V0, _V1)                                                          \
+    __math_results_t<_V0, _V1>                                                                     \
     __2x_##fn(_V0, _V0, _V1, _V1) noexcept;                                                        \
 												   \
   template <_TargetTraits _Traits = {}, __math_floating_point _Vp>                                 \
@@ -343,7 +632,18 @@ namespace simd
 	return std::fn(__x[0], __y[0]);                                                            \
       else if constexpr (_Traits.template _M_eval_as_f32<typename _Vp::value_type>())              \
 	return _Vp(fn<_Traits, rebind_t<float, _Vp>>(__x, __y));                                   \
-      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_fast_math())                    \
+      else if constexpr (inline_kernel && _Vp::abi_type::_S_nreg == 1 && _Traits._M_approx_math()) \
+	return __fast_##fn##_kernel(__x, __y);                                                     \
+      else if constexpr (inline_kernel && _Vp::abi_type::_S_nreg == 1)                             \
+	return __##fn##_kernel<_Traits>(__x, __y);                                                 \
+      else if constexpr (inline_kernel)                                                            \
+	return _Vp::_S_init(fn<_Traits>(__x._M_get_low(), __y._M_get_low()),                       \
+			    fn<_Traits>(__x._M_get_high(), __y._M_get_high()));                    \
+      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_allows_ulp(4)                   \
+			   && __use_libmvec<_Vp>(allow_clone && _GLIBCXX_SIMD_HAS_LIBMVEC(fn),     \
+						 allow_clone && _GLIBCXX_SIMD_HAS_SIMD_CLONE(fn))) \
+	return __libmvec_##fn<_ArchTraits(_Traits)>(__x._M_get(), __y._M_get());                   \
+      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_approx_math())                  \
 	return __fast_##fn<_ArchTraits(_Traits)._M_math_abi()>(__x._M_get(), __y._M_get());        \
       else if constexpr (_Vp::abi_type::_S_nreg == 1)                                              \
 	return __##fn<_Traits._M_math_abi()>(__x._M_get(), __y._M_get());                          \
@@ -783,7 +1083,7 @@ namespace simd
   _GLIBCXX_SIMD_MATH_CALL(acos)
   _GLIBCXX_SIMD_MATH_CALL(asin)
   _GLIBCXX_SIMD_MATH_CALL(atan)
-  _GLIBCXX_SIMD_MATH_CALL2(atan2, true)
+  _GLIBCXX_SIMD_MATH_CALL2(atan2, true, false)
   _GLIBCXX_SIMD_MATH_CALL(cos)
   _GLIBCXX_SIMD_MATH_CALL(sin)
   _GLIBCXX_SIMD_MATH_CALL(tan)
@@ -806,7 +1106,7 @@ namespace simd
 
   _GLIBCXX_SIMD_MATH_CALL(cbrt)
 
-  _GLIBCXX_SIMD_MATH_CALL2(hypot, false)
+  _GLIBCXX_SIMD_MATH_CALL2(hypot, false, VIR_MATH_INLINE)
 
   template <_ArchTraits, typename _TV>
     [[__gnu__::__const__]]
@@ -815,7 +1115,7 @@ namespace simd
 
   template <_ArchTraits, typename _V0, typename _V1>
     [[__gnu__::__const__]]
-    extern _GLIBCXX_SIMD_MATH_RET_TYPE(_V0, _V1)
+    extern __math_results_t<_V0, _V1>
     __fast_2x_hypot(_V0, _V0, _V0, _V1, _V1, _V1) noexcept;
 
   template <_TargetTraits, typename _TV>
@@ -823,7 +1123,7 @@ namespace simd
     __hypot(_TV, _TV, _TV) noexcept;
 
   template <_TargetTraits, typename _V0, typename _V1>
-    extern _GLIBCXX_SIMD_MATH_RET_TYPE(_V0, _V1)
+    extern __math_results_t<_V0, _V1>
     __2x_hypot(_V0, _V0, _V0, _V1, _V1, _V1) noexcept;
 
   template<_TargetTraits _Traits = {}, typename _Vp>
@@ -842,21 +1142,28 @@ namespace simd
 	return std::hypot(__x[0], __y[0], __z[0]);
       else if constexpr (_Traits.template _M_eval_as_f32<typename _Vp::value_type>())
 	return _Vp(hypot<_Traits, rebind_t<float, _Vp>>(__x, __y, __z));
+      else if constexpr (VIR_MATH_INLINE && _Vp::abi_type::_S_nreg == 1
+			   && _Traits._M_approx_math())
+	return __fast_hypot_kernel(__x, __y, __z);
+      else if constexpr (VIR_MATH_INLINE && _Vp::abi_type::_S_nreg == 1)
+	return __hypot_kernel<_Traits>(__x, __y, __z);
+      else if constexpr (VIR_MATH_INLINE)
+	return _Vp::_S_init(hypot<_Traits>(__x._M_get_low(), __y._M_get_low(), __z._M_get_low()),
+			    hypot<_Traits>(__x._M_get_high(), __y._M_get_high(),
+					   __z._M_get_high()));
       else if constexpr (_Vp::abi_type::_S_nreg > 2)
 	return _Vp::_S_init(hypot<_Traits>(__x._M_get_low(), __y._M_get_low()),
 			    hypot<_Traits>(__x._M_get_high(), __y._M_get_high()));
-      else if constexpr (__can_dispatch_2x<_Vp>() && _Traits._M_fast_math())
-	{
-	  _GLIBCXX_SIMD_MATH_2X_CALL3(__fast_2x_hypot<_ArchTraits(_Traits)._M_math_abi()>,
-				      __x, __y, __z);
-	  return _Vp::_S_init(__lo, __hi);
-	}
-      else if constexpr (__can_dispatch_2x<_Vp>() && !_Traits._M_fast_math())
-	{
-	  _GLIBCXX_SIMD_MATH_2X_CALL3(__2x_hypot<_Traits._M_math_abi()>, __x, __y, __z);
-	  return _Vp::_S_init(__lo, __hi);
-	}
-      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_fast_math())
+      else if constexpr (__can_dispatch_2x<_Vp>() && _Traits._M_approx_math())
+	return __math_call_2x<_Vp>([] [[__gnu__::__always_inline__]] (auto... __args) {
+				    return __fast_2x_hypot<_ArchTraits(_Traits)._M_math_abi()>(
+					     __args...);
+				  }, __x, __y, __z);
+      else if constexpr (__can_dispatch_2x<_Vp>() && !_Traits._M_approx_math())
+	return __math_call_2x<_Vp>([] [[__gnu__::__always_inline__]] (auto... __args) {
+				    return __2x_hypot<_Traits._M_math_abi()>(__args...);
+				  }, __x, __y, __z);
+      else if constexpr (_Vp::abi_type::_S_nreg == 1 && _Traits._M_approx_math())
 	return __fast_hypot<_ArchTraits(_Traits)._M_math_abi()>(__x._M_get(), __y._M_get(),
 								__z._M_get());
       else if constexpr (_Vp::abi_type::_S_nreg == 1)
@@ -867,7 +1174,7 @@ namespace simd
 
   _GLIBCXX_SIMD_MATH_3ARG_OVERLOADS(constexpr __deduced_vec_t<_Vp>, hypot)
 
-  _GLIBCXX_SIMD_MATH_CALL2(pow, true)
+  _GLIBCXX_SIMD_MATH_CALL2(pow, true, false)
 
   template <_TargetTraits _Traits, __vec_builtin _TV>
     [[__gnu__::__always_inline__]]
@@ -880,6 +1187,20 @@ namespace simd
 #if _GLIBCXX_X86
       if constexpr (sizeof(__x) < 16)
 	return _VecOps<_TV>::_S_extract(__sqrt<_Traits>(__vec_zero_pad_to_16(__x)));
+      else if constexpr (__is_float
+			   && (_Traits._M_max_ulp() >= 3
+				 || (_Traits._M_reciprocal_math() && _Traits._M_approx_math())))
+	{ // x * rsqrt(x) with one Newton step (like GCC's -mrecip=sqrt), about 3 ULP
+	  // rsqrtps flushes subnormal inputs to zero: scale them into the normal range (exact)
+	  const auto __tiny = __x < __FLT_MIN__;
+	  const _TV __xs = __tiny ? __x * 0x1p24f : __x;
+	  const _TV __r = __xs * __x86_rsqrt<1, true, _ArchTraits(_Traits)>(__xs)
+			    * (__tiny ? _TV() + 0x1p-12f : _TV() + 1.f);
+	  if constexpr (_Traits._M_finite_math_only())
+	    return __x == 0.f ? __x : __r;
+	  else
+	    return (__x == 0.f) | (__x == __builtin_inff()) ? __x : __r;
+	}
       else if constexpr (__is_double && sizeof(__x) == 16)
 	return __builtin_ia32_sqrtpd(__x);
       else if constexpr (__is_double && sizeof(__x) == 32)
@@ -909,6 +1230,80 @@ namespace simd
     sqrt(const _Vp& __x)
     { _GLIBCXX_SIMD_MATH_1ARG_IMPL(sqrt); }
 
+#if VIR_EXTENSIONS
+  /** @brief Returns an approximation of 1 / @p __x, refined with @p _Steps Newton-Raphson steps.
+   *
+   * The initial estimate has at least 11 correct bits (12 with SSE/AVX and 14 with AVX-512).
+   * Every step doubles that, i.e. float needs one step and double two steps (with AVX-512) for
+   * results within a few ULP. Subnormal inputs and results may be flushed to zero. Without a
+   * hardware estimate (e.g. double without AVX-512) the result is 1 / @p __x.
+   */
+  template <int _Steps = 1, _TargetTraits _Traits = {}, __math_floating_point _Vp>
+    requires (_Steps >= 0 && _Steps <= 2)
+    [[__gnu__::__always_inline__]]
+    constexpr __deduced_vec_t<_Vp>
+    rcp(const _Vp& __x)
+    {
+      using _Tp = typename __deduced_vec_t<_Vp>::value_type;
+      if constexpr (!is_same_v<_Vp, __deduced_vec_t<_Vp>>)
+	return rcp<_Steps, _Traits, __deduced_vec_t<_Vp>>(__x);
+      else if (__is_const_known(__x))
+	return _Vp(_Tp(1)) / __x;
+      else if constexpr (_Vp::size() == 1)
+	return _Tp(1) / __x[0];
+      else if constexpr (_Traits.template _M_eval_as_f32<_Tp>())
+	return _Vp(rcp<_Steps, _Traits>(rebind_t<float, _Vp>(__x)));
+      else if constexpr (_Vp::abi_type::_S_nreg > 1)
+	return _Vp::_S_init(rcp<_Steps, _Traits>(__x._M_get_low()),
+			    rcp<_Steps, _Traits>(__x._M_get_high()));
+#if _GLIBCXX_X86
+      else
+	return __x86_rcp<_Steps, _Traits._M_finite_math_only(), _ArchTraits(_Traits)>(
+		 __x._M_get());
+#else
+      else
+	return _Vp(_Tp(1)) / __x;
+#endif
+    }
+
+  /** @brief Returns an approximation of 1 / sqrt(@p __x), refined with @p _Steps Newton-Raphson
+   * steps.
+   *
+   * The precision is the same as for rcp. This is considerably faster than division by sqrt, e.g.
+   * for normalizing vectors.
+   */
+  template <int _Steps = 1, _TargetTraits _Traits = {}, __math_floating_point _Vp>
+    requires (_Steps >= 0 && _Steps <= 2)
+    [[__gnu__::__always_inline__]]
+    constexpr __deduced_vec_t<_Vp>
+    rsqrt(const _Vp& __x)
+    {
+      using _Tp = typename __deduced_vec_t<_Vp>::value_type;
+      if constexpr (!is_same_v<_Vp, __deduced_vec_t<_Vp>>)
+	return rsqrt<_Steps, _Traits, __deduced_vec_t<_Vp>>(__x);
+      else if (__is_const_known(__x))
+	return _Vp(_Tp(1)) / sqrt(__x);
+      else if constexpr (_Vp::size() == 1)
+	return _Tp(1) / std::sqrt(__x[0]);
+      else if constexpr (_Traits.template _M_eval_as_f32<_Tp>())
+	return _Vp(rsqrt<_Steps, _Traits>(rebind_t<float, _Vp>(__x)));
+      else if constexpr (_Vp::abi_type::_S_nreg > 1)
+	return _Vp::_S_init(rsqrt<_Steps, _Traits>(__x._M_get_low()),
+			    rsqrt<_Steps, _Traits>(__x._M_get_high()));
+#if _GLIBCXX_X86
+      else if constexpr (_Steps > 0 && is_same_v<_Tp, _Float16> && _Traits._M_have_avx512fp16())
+	// one step reaches the precision of _Float16
+	return __f16_rsqrt_kernel<_Traits>(__x);
+      else
+	return __x86_rsqrt<_Steps, _Traits._M_finite_math_only(), _ArchTraits(_Traits)>(
+		 __x._M_get());
+#else
+      else
+	return _Vp(_Tp(1)) / sqrt<_Traits>(__x);
+#endif
+    }
+
+#endif
   _GLIBCXX_SIMD_MATH_CALL(erf)
   _GLIBCXX_SIMD_MATH_CALL(erfc)
   _GLIBCXX_SIMD_MATH_CALL(lgamma)
@@ -1117,41 +1512,121 @@ namespace simd
     sph_neumann(const rebind_t<unsigned, __deduced_vec_t<_Vp>>& __n, const _Vp& __x)
     { static_assert(false, "TODO"); }
 
+  template <_TargetTraits, typename _TV>
+    extern __math_results_t<_TV, __vec_builtin_type<int, __width_of<_TV>>>
+    __frexp(_TV) noexcept;
+
+  template <_TargetTraits, typename _TV>
+    extern __math_results_t<_TV, __vec_builtin_type<int, __width_of<_TV>>>
+    __remquo(_TV, _TV) noexcept;
+
+  template <_TargetTraits, typename _TV>
+    extern __math_results_t<_TV, _TV>
+    __sincos(_TV) noexcept;
+
   template<_TargetTraits _Traits = {}, __math_floating_point _Vp>
     [[__gnu__::__always_inline__]]
     constexpr __deduced_vec_t<_Vp>
     frexp(const _Vp& __value, rebind_t<int, __deduced_vec_t<_Vp>>* __exp)
-    { static_assert(false, "TODO"); }
+    {
+      using _IVp = rebind_t<int, __deduced_vec_t<_Vp>>;
+      if constexpr (!is_same_v<_Vp, __deduced_vec_t<_Vp>>)
+	return frexp<_Traits, __deduced_vec_t<_Vp>>(__value, __exp);
+      else if (__is_const_known(__value))
+	{
+	  int __tmp[_Vp::size()] = {};
+	  const _Vp __r([&] [[__gnu__::__always_inline__]] (int __i) {
+		      return std::frexp(__value[__i], &__tmp[__i]);
+		    });
+	  *__exp = _IVp([&] [[__gnu__::__always_inline__]] (int __i) { return __tmp[__i]; });
+	  return __r;
+	}
+      else if constexpr (_Vp::size() == 1)
+	{
+	  int __e = 0;
+	  const _Vp __r = std::frexp(__value[0], &__e);
+	  *__exp = __e;
+	  return __r;
+	}
+      else if constexpr (_Traits.template _M_eval_as_f32<typename _Vp::value_type>())
+	return _Vp(frexp<_Traits>(rebind_t<float, _Vp>(__value), __exp));
+      else if constexpr (_Vp::abi_type::_S_nreg > 1)
+	{
+	  rebind_t<int, remove_cvref_t<decltype(__value._M_get_low())>> __e0;
+	  rebind_t<int, remove_cvref_t<decltype(__value._M_get_high())>> __e1;
+	  const auto __m0 = frexp<_Traits>(__value._M_get_low(), &__e0);
+	  const auto __m1 = frexp<_Traits>(__value._M_get_high(), &__e1);
+	  *__exp = cat(__e0, __e1);
+	  return _Vp::_S_init(__m0, __m1);
+	}
+      else if constexpr (VIR_MATH_INLINE)
+	return __frexp_kernel<_Traits>(__value, *__exp);
+      else
+	{
+	  using _TV = remove_cvref_t<decltype(declval<const _Vp&>()._M_get())>;
+	  using _ITV = __vec_builtin_type<int, __width_of<_TV>>;
+	  return __math_call<_TV, _ITV>(
+		   [&] [[__gnu__::__always_inline__]] {
+		     return __frexp<_Traits._M_math_abi()>(__value._M_get());
+		   },
+		   [&] [[__gnu__::__always_inline__]] (const _TV& __m, const _ITV& __e) {
+		     *__exp = _IVp::_S_init(__e);
+		     return _Vp::_S_init(__m);
+		   });
+	}
+    }
 
   template<_TargetTraits _Traits = {}, __math_floating_point _Vp>
     [[__gnu__::__always_inline__]]
     constexpr __deduced_vec_t<_Vp>
     remquo(const _Vp& __x, const _Vp& __y, rebind_t<int, __deduced_vec_t<_Vp>>* __quo)
     {
+      using _IVp = rebind_t<int, __deduced_vec_t<_Vp>>;
       if constexpr (!is_same_v<_Vp, __deduced_vec_t<_Vp>>)
 	return remquo<_Traits, __deduced_vec_t<_Vp>>(__x, __y, __quo);
-      else //if (__is_const_known(__x, __y))
+      else if (__is_const_known(__x, __y))
 	{
 	  int __tmp[_Vp::size()] = {};
 	  const _Vp __r([&] [[__gnu__::__always_inline__]] (int __i) {
 		      return std::remquo(__x[__i], __y[__i], &__tmp[__i]);
 		    });
-	  *__quo = rebind_t<int, __deduced_vec_t<_Vp>>(__tmp);
+	  *__quo = _IVp([&] [[__gnu__::__always_inline__]] (int __i) { return __tmp[__i]; });
 	  return __r;
 	}
-#if 0
       else if constexpr (_Vp::size() == 1)
 	{
-	  const _Vp __r = std::remquo(__x[0], __y[0], &__tmp[0]);
-	  *__quo = __tmp[0];
+	  int __q = 0;
+	  const _Vp __r = std::remquo(__x[0], __y[0], &__q);
+	  *__quo = __q;
 	  return __r;
 	}
       else if constexpr (_Traits.template _M_eval_as_f32<typename _Vp::value_type>())
-	// TODO: is __quo always of the correct type?
-	return _Vp(remquo<_Traits, rebind_t<float, _Vp>>(__x, __y, __quo));
+	// the remainder of two _Float16 values is exact in _Float16
+	return _Vp(remquo<_Traits>(rebind_t<float, _Vp>(__x), rebind_t<float, _Vp>(__y), __quo));
+      else if constexpr (_Vp::abi_type::_S_nreg > 1)
+	{
+	  rebind_t<int, remove_cvref_t<decltype(__x._M_get_low())>> __q0;
+	  rebind_t<int, remove_cvref_t<decltype(__x._M_get_high())>> __q1;
+	  const auto __r0 = remquo<_Traits>(__x._M_get_low(), __y._M_get_low(), &__q0);
+	  const auto __r1 = remquo<_Traits>(__x._M_get_high(), __y._M_get_high(), &__q1);
+	  *__quo = cat(__q0, __q1);
+	  return _Vp::_S_init(__r0, __r1);
+	}
+      else if constexpr (VIR_MATH_INLINE)
+	return __remquo_kernel<_Traits>(__x, __y, *__quo);
       else
-	static_assert(false, "TODO");
-#endif
+	{
+	  using _TV = remove_cvref_t<decltype(declval<const _Vp&>()._M_get())>;
+	  using _ITV = __vec_builtin_type<int, __width_of<_TV>>;
+	  return __math_call<_TV, _ITV>(
+		   [&] [[__gnu__::__always_inline__]] {
+		     return __remquo<_Traits._M_math_abi()>(__x._M_get(), __y._M_get());
+		   },
+		   [&] [[__gnu__::__always_inline__]] (const _TV& __r, const _ITV& __q) {
+		     *__quo = _IVp::_S_init(__q);
+		     return _Vp::_S_init(__r);
+		   });
+	}
     }
 
   template<_TargetTraits _Traits = {}, __math_floating_point _Vp>
@@ -1168,11 +1643,72 @@ namespace simd
 	   rebind_t<int, __deduced_vec_t<_Vp>>* __quo)
     { return remquo<_Traits, __deduced_vec_t<_Vp>>(__x, __y, __quo); }
 
+#if VIR_EXTENSIONS
+  /** @brief Computes sin(@p __x) and cos(@p __x) in one call (like the GNU sincos function).
+   *
+   * This shares the argument reduction of both functions. The result is within 2 ULP for double
+   * and (almost always) correctly rounded for float.
+   */
+  template<_TargetTraits _Traits = {}, __math_floating_point _Vp>
+    [[__gnu__::__always_inline__]]
+    constexpr void
+    sincos(const _Vp& __x, __deduced_vec_t<_Vp>* __sin, __deduced_vec_t<_Vp>* __cos)
+    {
+      if constexpr (!is_same_v<_Vp, __deduced_vec_t<_Vp>>)
+	sincos<_Traits, __deduced_vec_t<_Vp>>(__x, __sin, __cos);
+      else if (__is_const_known(__x))
+	{
+	  *__sin = _Vp([&] [[__gnu__::__always_inline__]] (int __i) { return std::sin(__x[__i]); });
+	  *__cos = _Vp([&] [[__gnu__::__always_inline__]] (int __i) { return std::cos(__x[__i]); });
+	}
+      else if constexpr (_Vp::size() == 1)
+	{
+	  *__sin = std::sin(__x[0]);
+	  *__cos = std::cos(__x[0]);
+	}
+      else if constexpr (_Traits.template _M_eval_as_f32<typename _Vp::value_type>())
+	{
+	  rebind_t<float, _Vp> __s, __c;
+	  sincos<_Traits>(rebind_t<float, _Vp>(__x), &__s, &__c);
+	  *__sin = _Vp(__s);
+	  *__cos = _Vp(__c);
+	}
+      else if constexpr (_Vp::abi_type::_S_nreg > 1)
+	{
+	  remove_cvref_t<decltype(__x._M_get_low())> __s0, __c0;
+	  remove_cvref_t<decltype(__x._M_get_high())> __s1, __c1;
+	  sincos<_Traits>(__x._M_get_low(), &__s0, &__c0);
+	  sincos<_Traits>(__x._M_get_high(), &__s1, &__c1);
+	  *__sin = _Vp::_S_init(__s0, __s1);
+	  *__cos = _Vp::_S_init(__c0, __c1);
+	}
+      else if constexpr (VIR_MATH_INLINE)
+	*__sin = __sincos_kernel<_Traits>(__x, *__cos);
+      else
+	{
+	  using _TV = remove_cvref_t<decltype(declval<const _Vp&>()._M_get())>;
+	  __math_call<_TV, _TV>(
+	    [&] [[__gnu__::__always_inline__]] {
+	      return __sincos<_Traits._M_math_abi()>(__x._M_get());
+	    },
+	    [&] [[__gnu__::__always_inline__]] (const _TV& __s, const _TV& __c) {
+	      *__sin = _Vp::_S_init(__s);
+	      *__cos = _Vp::_S_init(__c);
+	    });
+	}
+    }
+#endif
+
   template<class T, class Abi>
     [[__gnu__::__always_inline__]]
     constexpr basic_vec<T, Abi>
     modf(const type_identity_t<basic_vec<T, Abi>>& __value, basic_vec<T, Abi>* __iptr)
-    { static_assert(false, "TODO"); }
+    {
+      const basic_vec<T, Abi> __int = trunc(__value);
+      *__iptr = __int;
+      // the fractional part of ±inf is ±0, and it has the sign of __value (e.g. -2 → -0)
+      return copysign(select(isinf(__value), basic_vec<T, Abi>(), __value - __int), __value);
+    }
 #endif
 } // namespace simd
 
@@ -1180,10 +1716,17 @@ namespace simd
 // clean up internal macros
 #undef _GLIBCXX_SIMD_HAS_SIMD_CLONE
 #undef _GLIBCXX_SIMD_FN_NAME
-#undef _GLIBCXX_SIMD_MATH_2X_CALL
-#undef _GLIBCXX_SIMD_MATH_2X_CALL2
+#undef _GLIBCXX_SIMD_MATH_RESULTS_IN_REGS
 #undef _GLIBCXX_SIMD_MATH_CALL
 #undef _GLIBCXX_SIMD_MATH_CALL2
+#undef _GLIBCXX_SIMD_HAS_LIBMVEC
+#undef _GLIBCXX_SIMD_USE_F16_KERNEL
+#undef _GLIBCXX_SIMD_LIBMVEC
+#undef _GLIBCXX_SIMD_LIBMVEC2
+#undef _GLIBCXX_SIMD_LIBMVEC_ENTRIES
+#undef _GLIBCXX_SIMD_LIBMVEC_ENTRY
+#undef _GLIBCXX_SIMD_LIBMVEC_1ARG
+#undef _GLIBCXX_SIMD_LIBMVEC_2ARGS
 
   using simd::acos;
   using simd::asin;
@@ -1449,5 +1992,10 @@ _GLIBCXX_END_NAMESPACE_VERSION
 } // namespace std
 
 #pragma GCC diagnostic pop
+
+#if VIR_PATCH_MATH && (VIR_MATH_INLINE || defined __AVX512FP16__)
+#include "simd_math_kernels.h"
+#endif
+
 #endif // C++26
 #endif // _GLIBCXX_SIMD_MATH_H
@@ -0,0 +1,757 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2025–2026 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef _GLIBCXX_SIMD_MATH_KERNELS_H
+#define _GLIBCXX_SIMD_MATH_KERNELS_H 1
+
+#ifdef _GLIBCXX_SYSHDR
+#pragma GCC system_header
+#endif
+
+#if __cplusplus >= 202400L
+
+#include "simd_math.h"
+#include "simd_alg.h"
+#include "simd_mask_reductions.h"
+
+#include <limits>
+
+// psabi warnings are bogus because the ABI of the internal types never leaks into user code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// The math kernels of libsimd.so. The library wraps them in functions on builtin vectors (one per
+// math ABI). With VIR_MATH_INLINE, the math functions call them directly instead, which allows the
+// compiler to inline them into the caller's loops.
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace simd
+{
+#if VIR_PATCH_MATH
+  template <typename _Vp>
+    inline constexpr _Vp __fp_inf_v = numeric_limits<typename _Vp::value_type>::infinity();
+
+  template <typename _Vp>
+    inline constexpr _Vp __fp_norm_min_v = numeric_limits<typename _Vp::value_type>::min();
+
+  template <typename _Vp>
+    inline constexpr _Vp __fp_denorm_min_v
+      = numeric_limits<typename _Vp::value_type>::denorm_min();
+
+  template <typename _Vp>
+    inline constexpr _Vp __fp_mantissa_mask_v = __fp_norm_min_v<_Vp> - __fp_denorm_min_v<_Vp>;
+
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __fp_and(const _Vp& __a, const _Vp& __b)
+    { return __vec_and(__a._M_get(), __b._M_get()); }
+
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __fp_or(const _Vp& __a, const _Vp& __b)
+    { return __vec_or(__a._M_get(), __b._M_get()); }
+
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __fp_xor(const _Vp& __a, const _Vp& __b)
+    { return __vec_xor(__a._M_get(), __b._M_get()); }
+
+  /** @internal
+   * The floating-point type with twice the precision of @p _Tp, or void.
+   */
+  template <typename _Tp>
+    struct __increase_precision
+    { using type = void; };
+
+  template <>
+    struct __increase_precision<_Float16>
+    { using type = float; };
+
+  template <>
+    struct __increase_precision<float>
+    { using type = double; };
+
+  template <typename _Tp>
+    using __increase_precision_t = typename __increase_precision<_Tp>::type;
+
+  /** @internal
+   * True if a vec<_Tp, _Np> computed in the type of increased precision still fits into a single
+   * register.
+   */
+  template <typename _Tp, int _Np>
+    consteval bool
+    __can_increase_precision()
+    {
+      if constexpr (is_void_v<__increase_precision_t<_Tp>>)
+	return false;
+      else
+	return _Np <= vec<__increase_precision_t<_Tp>>::size();
+    }
+
+  /** @internal
+   * @brief Determines if x*x + y*y can be safely shortened to x*x under IEEE-754 rounding.
+   *
+   * The condition checks if the bit pattern difference between x and y is large enough such that
+   * y^2 is negligible compared to x^2 (i.e., y^2 < 0.5 * ulp(x^2)), ensuring x² + y² rounds to x².
+   * The threshold is derived from:
+   *   (digits + 2) << (digits - 2)
+   * where 'digits' is the floating-point precision (24 for float, 53 for double).
+   *
+   * Why this works:
+   * - For normalized values, bit patterns increase monotonically with magnitude
+   * - The threshold guarantees exponent difference >= (digits/2 + 1) (13 for float, 27 for double)
+   * - This ensures y < x * 2^(-digits/2), making y² < 0.5 * ulp(x^2)
+   *
+   * Example for float (24-bit precision) at threshold:
+   *   Threshold = (24+2) << (24-2) = 26 << 22
+   *   Let x = 2^100 (bit pattern: (100+127) << 23 = 227 << 23)
+   *   Let y = 2^87  (bit pattern: (87+127) << 23 = 214 << 23)
+   *   Bit diff = (227 - 214) << 23 = 26 << 22 (exactly threshold)
+   *   Then:
+   *     x² = 2^200, y² = 2^174
+   *     ulp(x²) = 2^(200-23) = 2^177
+   *     0.5 * ulp(x²) = 2^176
+   *     Since 2^174 < 2^176, x² + y² rounds to x²
+   *
+   * Example for double (53-bit precision) at threshold:
+   *   Threshold = (53+2) << (53-2) = 55 << 51
+   *   Let x = 2^1000 (bit pattern: (1000+1023) << 52 = 2023 << 52)
+   *   Let y = 1.5 * 2^972 (bit pattern: (972+1023) << 52 + (1 << 51) = 1995 << 52 + (1 << 51))
+   *   Bit diff = (2023 << 52) - (1995 << 52 + (1 << 51))
+   *            = (28 << 52) - (1 << 51)
+   *            = (56 << 51) - (1 << 51)
+   *            = 55 << 51 (exactly threshold)
+   *   Then:
+   *     x² = 2^2000, y² = (1.5)² * 2^1944 = 2.25 * 2^1944
+   *     ulp(x²) = 2^(2000-52) = 2^1948
+   *     0.5 * ulp(x²) = 2^1947
+   *     Since 2.25 * 2^1944 = 0.28125 * 2^1947 < 0.5 * 2^1947,
+   *     x² + y² rounds to x²
+   *
+   *
+   * @pre
+   * 1. x >= y >= 0
+   * 2. Only valid for normalized numbers (subnormals are irrelevant in this context)
+   *
+   * @note The condition is sufficient but not necessary (values below threshold might still round
+   * correctly).
+   */
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    constexpr typename _Vp::mask_type
+    __is_large_diff(const _Vp& __x, const _Vp& __y)
+    {
+      using _Tp = typename _Vp::value_type;
+      using _Ip = __integer_from<sizeof(_Tp)>;
+      using _IV = rebind_t<_Ip, _Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      _Ip __delta_exp = _Lp::digits + 2;
+      __delta_exp <<= _Lp::digits - 2; // -1 for implicit 1; another -1 for division by 2
+      return bit_cast<_IV>(__x) - bit_cast<_IV>(__y) >= __delta_exp;
+    }
+
+  /** @internal
+   * Adjusts all given arguments by @f$2^n@f$ and returns @f$2^-n@f$.
+   * @f$n = 1-\floor log_2 \mathtt{hi} \rfloor@f$
+   */
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __rescale_factors(_Vp& __hi, auto&... __to_scale)
+    {
+      constexpr _Vp __two = cw<2>;
+      constexpr _Vp __half = cw<1> / __two;
+      // round down to next power-of-2 = 2^(1-n) = 2*2^-n
+      const _Vp __hi_exp = __fp_and(__hi, __fp_inf_v<_Vp>);
+      const _Vp __scale = __fp_xor(__hi_exp, __fp_inf_v<_Vp>); // = 2/hi_exp = 2^n
+      __hi = __fp_or(__fp_and(__hi, __fp_mantissa_mask_v<_Vp>), __two); // = hi * scale
+      ((__to_scale *= __scale), ...);
+      return __half * __hi_exp; // = hi_exp/2 = 1/scale = 2^-n
+    }
+
+  // [simd.math.hypot] kernels ------------------------------------------------
+  // With fast-math, ignore precision of subnormals and inputs from
+  // finite_max/2 to finite_max. This removes all branching/masking.
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __fast_hypot_kernel(const _Vp& __x, const _Vp& __y)
+    {
+      using _Tp = typename _Vp::value_type;
+      if constexpr (__can_increase_precision<_Tp, _Vp::size()>())
+	{
+	  using _V2 = rebind_t<__increase_precision_t<_Tp>, _Vp>;
+	  return _Vp(sqrt(_V2(__x) * _V2(__x) + _V2(__y) * _V2(__y)));
+	}
+      else
+	{
+	  const _Vp __absx = fabs(__x); // no error
+	  const _Vp __absy = fabs(__y); // no error
+	  _Vp __hi = max(__absx, __absy); // no error
+	  _Vp __lo = min(__absx, __absy); // no error
+	  const auto __huge_diff = __is_large_diff(__hi, __lo);
+	  if (all_of(__huge_diff)) [[unlikely]]
+	    return __hi;
+	  // avoid denormals:
+	  __lo = select(__huge_diff, _Vp(), __lo);
+	  const _Vp __scale_back = __rescale_factors(__hi, __lo);
+	  return __scale_back * sqrt((__lo * __lo)._M_assoc_barrier() + __hi * __hi);
+	}
+    }
+
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __fast_hypot_kernel(const _Vp& __x, const _Vp& __y, const _Vp& __z)
+    {
+      using _Tp = typename _Vp::value_type;
+      if constexpr (__can_increase_precision<_Tp, _Vp::size()>())
+	{
+	  using _V2 = rebind_t<__increase_precision_t<_Tp>, _Vp>;
+	  return _Vp(sqrt(_V2(__x) * _V2(__x) + _V2(__y) * _V2(__y) + _V2(__z) * _V2(__z)));
+	}
+      else
+	{
+	  const _Vp __absx = fabs(__x);                  // no error
+	  const _Vp __absy = fabs(__y);                  // no error
+	  const _Vp __absz = fabs(__z);                  // no error
+	  _Vp __hi = max(max(__absx, __absy), __absz);   // no error
+	  _Vp __l0 = min(__absz, max(__absx, __absy));   // no error
+	  _Vp __l1 = min(__absy, __absx);                // no error
+	  const auto __huge_diff = __is_large_diff(__hi, __l0 + __l1);
+	  if (all_of(__huge_diff)) [[unlikely]]
+	    return __hi;
+	  // avoid denormals:
+	  __l0 = select(__huge_diff, _Vp(), __l0);
+	  __l1 = select(__huge_diff, _Vp(), __l1);
+	  const _Vp __scale_back = __rescale_factors(__hi, __l0, __l1);
+	  const _Vp __lo = __l0 * __l0 + __l1 * __l1; // add the two smaller values first
+	  return __scale_back * sqrt(__lo._M_assoc_barrier() + __hi * __hi);
+	}
+    }
+
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __hypot_kernel(const _Vp& __x, const _Vp& __y)
+    {
+      using _Tp = typename _Vp::value_type;
+      using _Lp = numeric_limits<_Tp>;
+      using _Mp = typename _Vp::mask_type;
+      if constexpr (__can_increase_precision<_Tp, _Vp::size()>())
+	{
+	  using _V2 = rebind_t<__increase_precision_t<_Tp>, _Vp>;
+	  const _Vp __r = _Vp(sqrt(_V2(__x) * _V2(__x) + _V2(__y) * _V2(__y)));
+	  if (all_of(isfinite(__x) && isfinite(__y))) [[likely]]
+	    return __r;
+	  return select(isinf(__x) || isinf(__y), __fp_inf_v<_Vp>, __r);
+	}
+      else
+	{
+	  // NaN inputs to min/max are UB (requires totally_ordered), replace inputs where a NaN
+	  // output is needed with precise 3²+4²=5².
+	  const _Mp __nan = isunordered(__x, __y);
+	  const _Vp __absx = select(__nan, _Tp(3), fabs(__x)); // no error
+	  const _Vp __absy = select(__nan, _Tp(4), fabs(__y)); // no error
+	  _Vp __hi = max(__absx, __absy); // no error
+	  _Vp __lo = min(__absx, __absy); // no error
+	  const auto __huge_diff = __is_large_diff(__hi, __lo);
+	  if (all_of(__huge_diff)) [[unlikely]]
+	    return __hi;
+	  __lo = select(__huge_diff, _Vp(), __lo);
+	  if (all_of(isnormal(__x)) && all_of(isnormal(__y))) [[likely]]
+	    {
+	      const _Vp __scale_back = __rescale_factors(__hi, __lo);
+	      return __scale_back * sqrt((__lo * __lo)._M_assoc_barrier() + __hi * __hi);
+	    }
+	  else if (all_of(isnormal(__x) || __x == _Tp(0)) && all_of(isnormal(__y) || __y == _Tp(0)))
+	    { // more likely and cheaper than the branch below
+	      const auto __k0 = __lo == _Tp(0);
+	      const auto __h0 = __hi;
+	      __hi = select(__hi == _Tp(0), _Tp(1), __hi);
+	      const _Vp __scale_back = __rescale_factors(__hi, __lo);
+	      const _Vp __r = __scale_back * sqrt((__lo * __lo)._M_assoc_barrier() + __hi * __hi);
+	      return select(__k0, __h0, __r);
+	    }
+	  else
+	    {
+	      const _Mp __inf = isinf(__x) || isinf(__y);
+	      // avoid potential FE_OVERFLOW
+	      __lo = select(__inf && !__nan, __fp_norm_min_v<_Vp>, __lo);
+	      // slower path to support subnormals
+	      // if hi is subnormal, avoid scaling by inf & final mul by 0
+	      // (which yields NaN) by using min()
+	      constexpr _Vp __subnorm_scale = _Tp(1) / __fp_norm_min_v<_Vp>;
+	      // invert exponent w/o error and w/o using the slow divider
+	      // unit: xor inverts the exponent but off by 1. Multiplication
+	      // with .5 adjusts for the discrepancy.
+	      const _Vp __scale
+		= select(isnormal(__hi), // hi == inf must be excluded to avoid FE_INVALID
+			 __fp_xor(__fp_and(__hi, __fp_inf_v<_Vp>), __fp_inf_v<_Vp>) * _Tp(.5),
+			 __subnorm_scale);
+	      // adjust final exponent for subnormal inputs
+	      const _Vp __hi_exp = select(isnormal(__hi), __fp_and(__hi, __fp_inf_v<_Vp>),
+					  __fp_norm_min_v<_Vp>); // no error
+	      const _Vp __h1 = __hi * __scale; // no error
+	      __lo *= __scale;                 // no error
+	      const _Vp __r = __hi_exp * sqrt((__lo * __lo)._M_assoc_barrier() + __h1 * __h1);
+	      if constexpr (_Traits._M_finite_math_only())
+		return __r;
+
+	      _Vp __fixup = __hi; // lo == 0
+	      __fixup = select(__nan, _Lp::quiet_NaN(), __fixup);
+	      __fixup = select(__inf, _Lp::infinity(), __fixup);
+	      // Instead of lo == 0, the following could depend on h1² == h1² + lo (i.e. hi is so
+	      // much larger than the other two inputs that the result is exactly hi). While this may
+	      // improve precision, it is likely to reduce efficiency if the ISA has FMAs (because
+	      // h1² + lo is an FMA, but the intermediate h1² must be kept)
+	      return select(__lo == _Tp(0) || __nan || __inf, __fixup, __r);
+	    }
+	}
+    }
+
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __hypot_kernel(const _Vp& __x, const _Vp& __y, const _Vp& __z)
+    {
+      using _Tp = typename _Vp::value_type;
+      using _Lp = numeric_limits<_Tp>;
+      if constexpr (__can_increase_precision<_Tp, _Vp::size()>())
+	{
+	  using _V2 = rebind_t<__increase_precision_t<_Tp>, _Vp>;
+	  const _Vp __r = _Vp(sqrt(_V2(__x) * _V2(__x) + _V2(__y) * _V2(__y) + _V2(__z) * _V2(__z)));
+	  if (all_of(isfinite(__x) && isfinite(__y) && isfinite(__z))) [[likely]]
+	    return __r;
+	  return select(isinf(__x) || isinf(__y) || isinf(__z), __fp_inf_v<_Vp>, __r);
+	}
+      else
+	{
+	  // NaN inputs to min/max are UB (requires totally_ordered), replace inputs where a NaN
+	  // output is needed with precise 2²+3²+6²=7².
+	  const auto __nan = isunordered(__x, __y + __z);
+	  const _Vp __absx = select(__nan, _Tp(2), fabs(__x)); // no error
+	  const _Vp __absy = select(__nan, _Tp(3), fabs(__y)); // no error
+	  const _Vp __absz = select(__nan, _Tp(6), fabs(__z)); // no error
+	  _Vp __hi = max(max(__absx, __absy), __absz);   // no error
+	  _Vp __l0 = min(__absz, max(__absx, __absy));   // no error
+	  _Vp __l1 = min(__absy, __absx);                // no error
+	  const auto __huge_diff = __is_large_diff(__hi, __l0 + __l1);
+	  if (all_of(__huge_diff)) [[unlikely]]
+	    return __hi;
+	  // avoid denormals:
+	  __l0 = select(__huge_diff, _Vp(), __l0);
+	  __l1 = select(__huge_diff, _Vp(), __l1);
+	  if (all_of(isnormal(__x)) && all_of(isnormal(__y)) && all_of(isnormal(__z))) [[likely]]
+	    {
+	      const _Vp __scale_back = __rescale_factors(__hi, __l0, __l1);
+	      const _Vp __lo = __l0 * __l0 + __l1 * __l1; // add the two smaller values first
+	      return __scale_back * sqrt(__lo._M_assoc_barrier() + __hi * __hi);
+	    }
+	  else
+	    {
+	      // slower path to support subnormals
+	      // if hi is subnormal, avoid scaling by inf & final mul by 0
+	      // (which yields NaN) by using min()
+	      constexpr _Vp __subnorm_scale = cw<1> / __fp_norm_min_v<_Vp>;
+	      // invert exponent w/o error and w/o using the slow divider
+	      // unit: xor inverts the exponent but off by 1. Multiplication
+	      // with .5 adjusts for the discrepancy.
+	      const _Vp __scale
+		= select(__hi >= __fp_norm_min_v<_Vp>,
+			 __fp_xor(__fp_and(__hi, __fp_inf_v<_Vp>), __fp_inf_v<_Vp>) * _Tp(.5),
+			 __subnorm_scale);
+	      // adjust final exponent for subnormal inputs
+	      const _Vp __hi_exp = select(__hi >= __fp_norm_min_v<_Vp>,
+					  __fp_and(__hi, __fp_inf_v<_Vp>),
+					  __fp_norm_min_v<_Vp>); // no error
+	      const _Vp __h1 = __hi * __scale; // no error
+	      __l0 *= __scale;                 // no error
+	      __l1 *= __scale;                 // no error
+	      const _Vp __lo = __l0 * __l0 + __l1 * __l1; // add the two smaller values first
+	      const _Vp __r = __hi_exp * sqrt(__lo._M_assoc_barrier() + __h1 * __h1);
+	      if constexpr (_Traits._M_finite_math_only())
+		return __r;
+
+	      const auto __inf = isinf(__x) || isinf(__y) || isinf(__z);
+	      _Vp __fixup = __hi; // lo == 0
+	      __fixup = select(__nan, _Lp::quiet_NaN(), __fixup);
+	      __fixup = select(__inf, _Lp::infinity(), __fixup);
+	      // See the two-argument kernel on why this doesn't test for h1² == h1² + lo.
+	      return select(__lo == cw<0> || __nan || __inf, __fixup, __r);
+	    }
+	}
+    }
+
+  // sincos, frexp, and remquo kernels -----------------------------------------
+  // These return one result and write the other to an out parameter. The library wraps them into
+  // entry points with two results (see __math_return).
+
+  /** @internal
+   * Returns sin(@p __x) and sets @p __cos to cos(@p __x).
+   *
+   * x = k·π/2 + r, |r| <= π/4, using the Cephes polynomials for sin and cos of r (within 2 ULP in
+   * double). In float, the Cody-Waite reduction loses too many bits close to multiples of π/2;
+   * therefore float computes in double, which is correctly rounded in almost all cases.
+   */
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __sincos_kernel(const _Vp& __x, _Vp& __cos)
+    {
+      using _Tp = typename _Vp::value_type;
+      if constexpr (is_same_v<_Tp, float>)
+	{
+	  using _Dp = rebind_t<double, _Vp>;
+	  _Dp __c;
+	  const _Vp __s = _Vp(__sincos_kernel<_Traits>(_Dp(__x), __c));
+	  __cos = _Vp(__c);
+	  return __s;
+	}
+      else if constexpr (_Vp::abi_type::_S_nreg > 1)
+	{
+	  remove_cvref_t<decltype(__x._M_get_low())> __c0;
+	  remove_cvref_t<decltype(__x._M_get_high())> __c1;
+	  const auto __s0 = __sincos_kernel<_Traits>(__x._M_get_low(), __c0);
+	  const auto __s1 = __sincos_kernel<_Traits>(__x._M_get_high(), __c1);
+	  __cos = _Vp::_S_init(__c0, __c1);
+	  return _Vp::_S_init(__s0, __s1);
+	}
+      else
+	{
+	  static_assert(is_same_v<_Tp, double>);
+	  using _IV = rebind_t<long long, _Vp>;
+	  constexpr _Vp __shifter = 0x1.8p52; // ulp(x) is 1 in [2^52, 2^53)
+	  const _Vp __k0 = (__x * 0x1.45f306dc9c883p-1 + __shifter)._M_assoc_barrier();
+	  const _IV __q = bit_cast<_IV>(__k0) - bit_cast<_IV>(__shifter);
+	  const _Vp __k = __k0 - __shifter;
+	  // π/2 in three parts, where k·part is exact for |x| < 2^20
+	  _Vp __r = __x - __k * 1.57079625129699707031;
+	  __r -= __k * 7.54978941586159635336e-8;
+	  __r -= __k * 5.39030285815811905290e-15;
+	  // The reduction has an absolute error of ~|k|·2^-99, which is too much for r close to 0.
+	  // Such arguments, |x| >= 2^20, inf, and NaN are rare enough to use the scalar functions.
+	  if (any_of(!(fabs(__x) < 0x1p20) || fabs(__r) < fabs(__k) * 0x1p-46)) [[unlikely]]
+	    {
+	      __cos = _Vp([&] [[__gnu__::__always_inline__]] (int __i) {
+			return std::cos(__x[__i]);
+		      });
+	      return _Vp([&] [[__gnu__::__always_inline__]] (int __i) {
+		       return std::sin(__x[__i]);
+		     });
+	    }
+	  const _Vp __z = __r * __r;
+	  _Vp __ps = __z * 1.58962301576546568060e-10 - 2.50507477628578072866e-8;
+	  __ps = __ps * __z + 2.75573136213857245213e-6;
+	  __ps = __ps * __z - 1.98412698295895385996e-4;
+	  __ps = __ps * __z + 8.33333333332211858878e-3;
+	  __ps = __ps * __z - 1.66666666666666307295e-1;
+	  _Vp __pc = __z * -1.13585365213876817300e-11 + 2.08757008419747316778e-9;
+	  __pc = __pc * __z - 2.75573141792967388112e-7;
+	  __pc = __pc * __z + 2.48015872888517045348e-5;
+	  __pc = __pc * __z - 1.38888888888730564116e-3;
+	  __pc = __pc * __z + 4.16666666666665929218e-2;
+	  _Vp __sin = __r + __r * __z * __ps;
+	  if constexpr (_Traits._M_signed_zeros())
+	    __sin = select(__x == 0., __x, __sin); // r + r·… is +0 for x = -0
+	  const _Vp __cos0 = 1. - __z * .5 + __z * __z * __pc;
+	  // odd quadrants use the other polynomial, quadrants 2 and 3 flip the sign
+	  auto __quadrant = [&] [[__gnu__::__always_inline__]] (const _IV& __n) {
+	    const _Vp __odd = bit_cast<_Vp>(-(__n & cw<1>));
+	    const _Vp __r0 = __fp_xor(__sin, __fp_and(__fp_xor(__sin, __cos0), __odd));
+	    return __fp_xor(__r0, bit_cast<_Vp>((__n & cw<2>) << 62));
+	  };
+	  __cos = __quadrant(__q + cw<1>);
+	  return __quadrant(__q);
+	}
+    }
+
+  /** @internal
+   * Returns the mantissa of @p __x in [0.5, 1) (with the sign of @p __x) and sets @p __exp such
+   * that x = mantissa·2^exp. Zero, inf, and NaN are returned unchanged with exp = 0.
+   */
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __frexp_kernel(const _Vp& __x, rebind_t<int, _Vp>& __exp)
+    {
+      using _Tp = typename _Vp::value_type;
+      using _IV = rebind_t<__integer_from<sizeof(_Tp)>, _Vp>;
+      using _Lp = numeric_limits<_Tp>;
+      constexpr int __bias = _Lp::max_exponent - 1;
+      const _IV __abits = bit_cast<_IV>(fabs(__x));
+      // scale subnormals into the normal range
+      const typename _Vp::mask_type __subnormal = __abits < bit_cast<_IV>(__fp_norm_min_v<_Vp>);
+      const _Vp __xn = select(__subnormal, __x * _Tp(1ull << _Lp::digits), __x);
+      const _IV __bits = bit_cast<_IV>(__xn);
+      _IV __e = ((__bits >> (_Lp::digits - 1)) & cw<2 * __bias + 1>) - cw<__bias - 1>;
+      __e -= select(__subnormal, _IV(_Lp::digits), _IV());
+      const typename _Vp::mask_type __special
+	= __abits == cw<0> || __abits >= bit_cast<_IV>(__fp_inf_v<_Vp>);
+      __exp = rebind_t<int, _Vp>(select(__special, _IV(), __e));
+      const _Vp __m = __fp_or(__fp_and(__xn, __fp_or(__fp_mantissa_mask_v<_Vp>, _Vp(_Tp(-0.)))),
+			      _Vp(_Tp(.5)));
+      return select(__special, __x, __m);
+    }
+
+  /** @internal
+   * Returns remainder(@p __x, @p __y) and sets @p __quo to the sign of x/y times the three low
+   * bits of the integral quotient.
+   *
+   * n = round(|x/y|) is exact for |x/y| < 2^(digits-2), and then FMA computes the exact remainder
+   * |x| - n·|y|. Since |x/y| is rounded, n can be off by one, which the fixup corrects (including
+   * the ties-to-even rule). Larger quotients, y = 0, inf, and NaN use the scalar remquo, as does
+   * every lane without FMA.
+   */
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __remquo_kernel(const _Vp& __x, const _Vp& __y, rebind_t<int, _Vp>& __quo)
+    {
+      using _Tp = typename _Vp::value_type;
+      using _QV = rebind_t<int, _Vp>;
+      auto __scalar = [&] [[__gnu__::__always_inline__]] (auto __use_scalar, const _Vp& __r) {
+	int __tmp[_Vp::size()] = {};
+	const _Vp __rs([&] [[__gnu__::__always_inline__]] (int __i) {
+		   return __use_scalar(__i) ? std::remquo(__x[__i], __y[__i], &__tmp[__i])
+					    : __r[__i];
+		 });
+	__quo = _QV([&] [[__gnu__::__always_inline__]] (int __i) {
+		  return __use_scalar(__i) ? __tmp[__i] : __quo[__i];
+		});
+	return __rs;
+      };
+#if _GLIBCXX_X86
+      if constexpr (_Traits._M_have_fma())
+	{
+	  using _IV = rebind_t<__integer_from<sizeof(_Tp)>, _Vp>;
+	  using _TV = remove_cvref_t<decltype(__x._M_get())>;
+	  using _Lp = numeric_limits<_Tp>;
+	  const _Vp __ax = fabs(__x);
+	  const _Vp __ay = fabs(__y);
+	  const _Vp __q = __ax / __ay;
+	  constexpr _Vp __shifter = _Tp(3ull << (_Lp::digits - 2)); // ulp(x) is 1 close to it
+	  const _Vp __k = (__q + __shifter)._M_assoc_barrier();
+	  _IV __n = bit_cast<_IV>(__k) - bit_cast<_IV>(__shifter);
+	  const _Vp __nf = __k - __shifter;
+	  _Vp __r = __x86_fma<_TV, _ArchTraits(_Traits)>((-__nf)._M_get(), __ay._M_get(),
+						       __ax._M_get());
+	  // 2r is only inf if |r| > |y|/2
+	  const _Vp __r2 = __r + __r;
+	  const typename _Vp::mask_type __odd = (__n & cw<1>) != cw<0>;
+	  const auto __up = __r2 > __ay || (__r2 == __ay && __odd);
+	  const auto __down = __r2 < -__ay || (__r2 == -__ay && __odd);
+	  __r = select(__up, __r - __ay, select(__down, __r + __ay, __r));
+	  __n = select(__up, __n + cw<1>, select(__down, __n - cw<1>, __n));
+	  // the sign of x (also for r = 0) and quo
+	  __r = __fp_xor(__r, __fp_and(__x, _Vp(_Tp(-0.))));
+	  const _IV __n3 = __n & cw<7>;
+	  __quo = _QV(select(bit_cast<_IV>(__fp_xor(__x, __y)) < cw<0>, -__n3, __n3));
+	  auto __slow = !(__q < _Tp(1ull << (_Lp::digits - 2)));
+	  if constexpr (!_Traits._M_finite_math_only())
+	    __slow = __slow || __ay == __fp_inf_v<_Vp>;
+	  if (any_of(__slow)) [[unlikely]]
+	    return __scalar([&](int __i) { return __slow[__i]; }, __r);
+	  return __r;
+	}
+      else
+#endif
+	return __scalar([](int) { return true; }, _Vp());
+    }
+
+  // [simd.math] _Float16 kernels ----------------------------------------------
+  // With AVX512FP16, exp, log, sin, cos, tanh, and rsqrt compute in _Float16 instead of converting
+  // to float (which would halve the number of lanes per instruction). These kernels are always
+  // inlined; libsimd.so has no _Float16 entry points for them. The polynomials are tuned to half
+  // precision: over all 2^16 inputs (determined with an emulation of the _Float16 arithmetic, with
+  // and without FMA contraction) the error is at most 1 ULP for exp, 2 ULP for log, sin, and tanh,
+  // and 3.2 ULP for cos close to its zeros. That is a relative error of ~2e-3 at worst.
+  // Subnormal results are double-rounded. __f16_kernel_max_ulp in simd_math.h lists these bounds;
+  // the math functions only use a kernel if its bound fits the requested precision.
+
+  /** @internal
+   * Returns round(@p __x * @p __scale) and sets @p __n to the same integer.
+   *
+   * @pre |__x * __scale| < 512
+   */
+  template <typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_round_scaled(const _Vp& __x, _Float16 __scale, rebind_t<short, _Vp>& __n)
+    {
+      using _IV = rebind_t<short, _Vp>;
+      constexpr _Vp __shifter = _Float16(0x1.8p10); // ulp(x) is 1 in [1024, 2048)
+      const _Vp __k = __x * __scale + __shifter;
+      __n = bit_cast<_IV>(__k) - bit_cast<_IV>(__shifter);
+      return __k - __shifter;
+    }
+
+  /** @internal
+   * Returns 2^@p __n.
+   *
+   * @pre -15 < __n < 16
+   */
+  template <typename _IV>
+    [[__gnu__::__always_inline__]]
+    inline rebind_t<_Float16, _IV>
+    __f16_exp2i(const _IV& __n)
+    { return bit_cast<rebind_t<_Float16, _IV>>((__n + cw<15>) << 10); }
+
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_exp_kernel(const _Vp& __x)
+    {
+      using _IV = rebind_t<short, _Vp>;
+      // exp(12) = inf and exp(-18) = 0 in _Float16; the bounds keep 2^(n/2) normal
+      _Vp __xc = select(__x > _Float16(12), _Float16(12), __x);
+      __xc = select(__xc < _Float16(-18), _Float16(-18), __xc);
+      // x = k·ln2 + r, |r| <= ln2/2; k·ln2_hi is exact for |k| < 2^7
+      _IV __n;
+      const _Vp __k = __f16_round_scaled(__xc, _Float16(0x1.715476p0), __n);
+      _Vp __r = __xc - __k * _Float16(0x1.6p-1);
+      __r -= __k * _Float16(0x1.62e42fefa39efp-1 - 0x1.6p-1);
+      _Vp __p = __r * _Float16(1. / 24) + _Float16(1. / 6);
+      __p = __p * __r + _Float16(.5);
+      __p = __p * __r + _Float16(1);
+      __p = __p * __r + _Float16(1);
+      // scale in two steps because 2^k overflows/underflows the exponent field for some k
+      const _IV __n1 = __n >> 1;
+      return __p * __f16_exp2i(__n1) * __f16_exp2i(__n - __n1);
+    }
+
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_log_kernel(const _Vp& __x)
+    {
+      using _IV = rebind_t<short, _Vp>;
+      constexpr _Float16 __ln2_hi = _Float16(0x1.6p-1);
+      constexpr _Float16 __ln2_lo = _Float16(0x1.62e42fefa39efp-1 - 0x1.6p-1);
+      // x = m·2^e with m in [sqrt(1/2), sqrt(2))
+      const auto __subnormal = __x < __fp_norm_min_v<_Vp>;
+      const _IV __bits = bit_cast<_IV>(select(__subnormal, __x * _Float16(0x1p10), __x));
+      _Vp __e = _Vp((__bits >> 10) - cw<15>) - select(__subnormal, _Vp(_Float16(10)), _Vp());
+      _Vp __m = bit_cast<_Vp>((__bits & cw<0x3ff>) | cw<0x3c00>);
+      const auto __big = __m > _Float16(1.41421356);
+      __m = select(__big, __m * _Float16(.5), __m);
+      __e += select(__big, _Vp(_Float16(1)), _Vp());
+      // log(m) = 2·atanh(s), |s| <= 0.172
+      const _Vp __s = (__m - _Float16(1)) / (__m + _Float16(1));
+      const _Vp __s2 = __s * __s;
+      const _Vp __p = (__s2 * _Float16(2. / 5) + _Float16(2. / 3)) * __s2 * __s + (__s + __s);
+      const _Vp __r = __e * __ln2_hi + (__e * __ln2_lo + __p);
+      if constexpr (_Traits._M_finite_math_only())
+	return __r;
+      else
+	return select(__x == _Float16(), -__fp_inf_v<_Vp>,
+		      select(__x == __fp_inf_v<_Vp>, __x,
+			     select(__x > _Float16(), __r,
+				    numeric_limits<_Float16>::quiet_NaN())));
+    }
+
+  /** @internal
+   * sin(@p __x) for @p _Quadrant = 0, cos(@p __x) for @p _Quadrant = 1.
+   */
+  template <_TargetTraits _Traits, int _Quadrant, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_sincos_kernel(const _Vp& __x)
+    {
+      using _IV = rebind_t<short, _Vp>;
+      // The reduction below needs |k| < 2^8. Larger arguments (and inf/NaN) are rare enough to
+      // fall back to float.
+      if (any_of(!(fabs(__x) <= _Float16(256)))) [[unlikely]]
+	{
+	  const rebind_t<float, _Vp> __xf = __x;
+	  if constexpr (_Quadrant == 0)
+	    return _Vp(sin<_Traits>(__xf));
+	  else
+	    return _Vp(cos<_Traits>(__xf));
+	}
+      // x = k·π/2 + r, |r| <= π/4; π/2 in four parts, where k·part is exact for |k| < 2^8
+      _IV __q;
+      const _Vp __k = __f16_round_scaled(__x, _Float16(0x1.45f306dc9c883p-1), __q);
+      const _Vp __k11 = __k * _Float16(0x1p-11);
+      _Vp __r = __x - __k * _Float16(1.5);
+      __r -= __k * _Float16(0x1.2p-4);
+      __r -= __k11;
+      __r -= __k11 * _Float16(-0x1.2aeef4bap-7);
+      const _Vp __r2 = __r * __r;
+      const _Vp __sin = (__r2 * _Float16(1. / 120) - _Float16(1. / 6)) * __r2 * __r + __r;
+      const _Vp __cos
+	= ((__r2 * _Float16(-1. / 720) + _Float16(1. / 24)) * __r2 - _Float16(.5)) * __r2
+	    + _Float16(1);
+      __q += cw<_Quadrant>;
+      // odd quadrants use the cos polynomial, quadrants 2 and 3 flip the sign
+      const _Vp __odd = bit_cast<_Vp>(-(__q & cw<1>));
+      const _Vp __r0 = __fp_xor(__sin, __fp_and(__fp_xor(__sin, __cos), __odd));
+      return __fp_xor(__r0, bit_cast<_Vp>((__q & cw<2>) << 14));
+    }
+
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_sin_kernel(const _Vp& __x)
+    { return __f16_sincos_kernel<_Traits, 0>(__x); }
+
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_cos_kernel(const _Vp& __x)
+    { return __f16_sincos_kernel<_Traits, 1>(__x); }
+
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_tanh_kernel(const _Vp& __x)
+    {
+      const _Vp __ax = fabs(__x);
+      const _Vp __x2 = __x * __x;
+      const _Vp __small
+	= ((__x2 * _Float16(-17. / 315) + _Float16(2. / 15)) * __x2 - _Float16(1. / 3)) * __x2
+	    * __x + __x;
+      if (all_of(__ax < _Float16(.55))) [[likely]]
+	return __small;
+      // tanh(|x|) = 1 - 2/(exp(2|x|) + 1), with the sign of x
+      const _Vp __e = __f16_exp_kernel<_Traits>(__ax + __ax);
+      const _Vp __large = __fp_or(_Float16(1) - _Float16(2) / (__e + _Float16(1)),
+				  __fp_and(__x, _Vp(_Float16(-0.))));
+      return select(__ax < _Float16(.55), __small, __large);
+    }
+
+#if _GLIBCXX_X86
+  /** @internal
+   * 1 / sqrt(@p __x) from the vrsqrtph estimate (relative error < 2^-11) refined with one Newton
+   * step, which computes the residual 1 - x·r² with FMA. The result is within 2 ULP (the rounding
+   * of x·r and of the final FMA). AVX512FP16 instructions never flush subnormals.
+   */
+  template <_TargetTraits _Traits, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    inline _Vp
+    __f16_rsqrt_kernel(const _Vp& __x)
+    {
+      using _TV = remove_cvref_t<decltype(__x._M_get())>;
+      const _Vp __r0 = __x86_rsqrt_estimate<_TV, _ArchTraits(_Traits)>(__x._M_get());
+      const _Vp __e = _Float16(1) - __x * __r0 * __r0;
+      const _Vp __r = __r0 * _Float16(.5) * __e + __r0;
+      if constexpr (_Traits._M_finite_math_only())
+	return __r;
+      else // x * r0 is NaN for ±0 and +inf, where the estimate is exact
+	return select(__r == __r, __r, __r0);
+    }
+#endif
+#endif // VIR_PATCH_MATH
+} // namespace simd
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#pragma GCC diagnostic pop
+#endif // C++26
+#endif // _GLIBCXX_SIMD_MATH_KERNELS_H
@@ -0,0 +1,322 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#ifndef _GLIBCXX_SIMD_POLYNOMIAL_H
+#define _GLIBCXX_SIMD_POLYNOMIAL_H 1
+
+#ifdef _GLIBCXX_SYSHDR
+#pragma GCC system_header
+#endif
+
+#if __cplusplus >= 202400L
+
+#include "simd_vec.h"
+
+#include <array>
+
+// psabi warnings are bogus because the ABI of the internal types never leaks into user code
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+#if VIR_EXTENSIONS
+// Polynomial evaluation with compile-time coefficients (extension) ---------
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+namespace simd
+{
+  /** @internal
+   * Number of independent multiply-adds that need to be in flight to keep the FP pipes busy
+   * (latency × throughput of a multiply-add step on the target of @p _Traits).
+   */
+  template <_ArchTraits _Traits = {}>
+    consteval int
+    __poly_parallelism()
+    {
+#if _GLIBCXX_X86
+      if constexpr (_Traits._M_have_fma())
+	return 4 * 2; // FMA: Skylake and later, Zen 2 to Zen 5
+      else if constexpr (_Traits._M_tune_zen())
+	return 6 * 2; // mul + add (3 + 3 cycles) on separate FMUL and FADD pipe pairs
+      else
+	return 8 * 1; // mul + add (4 + 4 cycles), sharing two ports
+#else
+      return 4 * 2; // FMA on ARM (Neoverse) cores
+#endif
+    }
+
+  /** @internal
+   * Returns the coefficients given as template arguments (either a pack of scalars or a single
+   * array) as array<_Tp, N>, lowest order first.
+   */
+  template <typename _Tp, auto... _Coeffs>
+    consteval auto
+    __poly_coeffs()
+    {
+      if constexpr (sizeof...(_Coeffs) == 1 && requires { _Coeffs...[0].size(); })
+	{
+	  array<_Tp, _Coeffs...[0].size()> __r = {};
+	  for (size_t __i = 0; __i < __r.size(); ++__i)
+	    __r[__i] = static_cast<_Tp>(_Coeffs...[0][__i]);
+	  return __r;
+	}
+      else
+	return array<_Tp, sizeof...(_Coeffs)> {static_cast<_Tp>(_Coeffs)...};
+    }
+
+  /** @internal
+   * Returns the block size for evaluating a polynomial with @p _Np coefficients on @p _Kp
+   * independent inputs.
+   *
+   * Horner's scheme needs the fewest operations but is a single dependency chain per input. If
+   * the inputs don't fill the pipes, the polynomial is split into blocks that are evaluated with
+   * Horner's scheme independently and then combined with Estrin's scheme. A block size of 2 is
+   * Estrin's scheme, a block size of @p _Np is Horner's scheme.
+   */
+  template <int _Np, int _Kp, _ArchTraits _Traits = {}>
+    consteval int
+    __poly_block_size()
+    {
+      constexpr int __parallelism = __poly_parallelism<_Traits>();
+      if (_Np <= 3 || _Kp >= __parallelism)
+	return _Np;
+      const int __chains = __div_ceil(__parallelism, _Kp);
+      return std::max(2, __div_ceil(_Np, __chains));
+    }
+
+  /** @internal
+   * True if @p _Coeffs is a constexpr array of coefficients (instead of a single coefficient).
+   */
+  template <auto _Coeffs>
+    concept __poly_coeff_array = requires { _Coeffs.size(); };
+
+  /** @internal
+   * True if @p _Coeffs are several coefficient arrays, i.e. several polynomials.
+   */
+  template <auto... _Coeffs>
+    concept __poly_coeff_sets = sizeof...(_Coeffs) > 1 && (__poly_coeff_array<_Coeffs> && ...);
+
+  /** @internal
+   * Returns @p __x to the power of @p _Np by repeated squaring.
+   */
+  template <int _Np, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    constexpr _Vp
+    __poly_pow(const _Vp& __x)
+    {
+      static_assert(_Np >= 1);
+      if constexpr (_Np == 1)
+	return __x;
+      else if constexpr (_Np % 2 == 1)
+	return __poly_pow<_Np - 1>(__x) * __x;
+      else
+	{
+	  const _Vp __h = __poly_pow<_Np / 2>(__x);
+	  return __h * __h;
+	}
+    }
+
+  /** @internal
+   * Number of levels of the Estrin tree that combines the blocks of a polynomial with @p _Np
+   * coefficients and block size @p _Block.
+   */
+  template <int _Np, int _Block>
+    consteval int
+    __poly_levels()
+    { return __bit_width(unsigned(__div_ceil(_Np, _Block) - 1)); }
+
+  /** @internal
+   * Returns x^_Block, x^(2·_Block), x^(4·_Block), … (@p _Levels powers) for every @p __x, i.e. the
+   * factors of the levels of the Estrin tree.
+   */
+  template <int _Block, int _Levels, typename _Vp, size_t _Kp>
+    [[__gnu__::__always_inline__]]
+    constexpr array<array<_Vp, _Kp>, _Levels>
+    __poly_powers(const array<_Vp, _Kp>& __x)
+    {
+      array<array<_Vp, _Kp>, _Levels> __y;
+      template for (constexpr int __level : _IotaArray<_Levels>)
+	template for (constexpr int __k : _IotaArray<_Kp>)
+	  if constexpr (__level == 0)
+	    __y[0][__k] = __poly_pow<_Block>(__x[__k]);
+	  else
+	    __y[__level][__k] = __y[__level - 1][__k] * __y[__level - 1][__k];
+      return __y;
+    }
+
+  /** @internal
+   * @brief Evaluates the polynomial with coefficients @p __c on all @p __x.
+   *
+   * The polynomial is split into blocks of @p _Block coefficients. The Horner steps of all blocks
+   * and all inputs are interleaved, followed by the Estrin tree, which multiplies with the powers
+   * @p __y of x (see __poly_powers; at least as many levels as the tree has).
+   */
+  template <int _Block, typename _Vp, size_t _Np, size_t _Kp, size_t _Lp>
+    [[__gnu__::__always_inline__]]
+    constexpr array<_Vp, _Kp>
+    __poly_eval(const array<typename _Vp::value_type, _Np>& __c, const array<_Vp, _Kp>& __x,
+		const array<array<_Vp, _Kp>, _Lp>& __y)
+    {
+      static_assert(_Block >= 1 && _Block <= int(_Np));
+      constexpr int __nblocks = __div_ceil(int(_Np), _Block);
+      constexpr int __levels = __poly_levels<int(_Np), _Block>();
+      static_assert(__levels <= int(_Lp));
+      array<array<_Vp, _Kp>, __nblocks> __p;
+      template for (constexpr int __j : _IotaArray<__nblocks>)
+	{
+	  constexpr int __last = std::min(__j * _Block + _Block, int(_Np)) - 1;
+	  template for (constexpr int __k : _IotaArray<_Kp>)
+	    __p[__j][__k] = _Vp(__c[__last]);
+	}
+      template for (constexpr int __i : _IotaArray<_Block - 1>)
+	template for (constexpr int __j : _IotaArray<__nblocks>)
+	  {
+	    // all blocks finish in the same step; the last block may be shorter and start later
+	    constexpr int __idx = __j * _Block + _Block - 2 - __i;
+	    if constexpr (__idx < std::min(__j * _Block + _Block, int(_Np)) - 1)
+	      template for (constexpr int __k : _IotaArray<_Kp>)
+		__p[__j][__k] = __p[__j][__k] * __x[__k] + __c[__idx];
+	  }
+      template for (constexpr int __level : _IotaArray<__levels>)
+	{
+	  constexpr int __n = __div_ceil(__nblocks, 1 << __level);
+	  template for (constexpr int __j : _IotaArray<__n / 2>)
+	    template for (constexpr int __k : _IotaArray<_Kp>)
+	      __p[__j][__k] = __p[2 * __j + 1][__k] * __y[__level][__k] + __p[2 * __j][__k];
+	  if constexpr (__n % 2 == 1)
+	    __p[__n / 2] = __p[__n - 1];
+	}
+      return __p[0];
+    }
+
+  /** @internal
+   * Same as above, but computes the powers of @p __x itself.
+   */
+  template <int _Block, typename _Vp, size_t _Np, size_t _Kp>
+    [[__gnu__::__always_inline__]]
+    constexpr array<_Vp, _Kp>
+    __poly_eval(const array<typename _Vp::value_type, _Np>& __c, const array<_Vp, _Kp>& __x)
+    {
+      constexpr int __levels = __poly_levels<int(_Np), _Block>();
+      return __poly_eval<_Block, _Vp>(__c, __x, __poly_powers<_Block, __levels>(__x));
+    }
+
+  /** @internal
+   * Evaluates the polynomial given by @p _Coeffs with block size @p _Block (0: choose
+   * automatically) and returns one result or an array of results.
+   */
+  template <int _Block, auto... _Coeffs, typename _Vp, typename... _Vps>
+    [[__gnu__::__always_inline__]]
+    constexpr auto
+    __poly_apply(const _Vp& __x, const _Vps&... __xs)
+    {
+      using _Tp = typename _Vp::value_type;
+      constexpr auto __c = __poly_coeffs<_Tp, _Coeffs...>();
+      constexpr int __n = __c.size();
+      constexpr int __k = 1 + sizeof...(_Vps);
+      static_assert(__n > 0, "a polynomial needs at least one coefficient");
+      constexpr int __block = _Block == 0 ? __poly_block_size<__n, __k>() : std::min(_Block, __n);
+      const array<_Vp, __k> __r = __poly_eval<__block, _Vp>(__c, array<_Vp, __k> {__x, __xs...});
+      if constexpr (__k == 1)
+	return __r[0];
+      else
+	return __r;
+    }
+
+  /** @internal
+   * Evaluates the polynomials given by the coefficient arrays @p _Sets on @p __x and returns an
+   * array of the results. All polynomials are independent dependency chains, which is taken into
+   * account for the block size. They use the same block size (or less for shorter polynomials)
+   * and thus share the powers of @p __x for their Estrin trees, which are computed only once.
+   */
+  template <int _Block, auto... _Sets, typename _Vp>
+    [[__gnu__::__always_inline__]]
+    constexpr array<_Vp, sizeof...(_Sets)>
+    __poly_apply_sets(const _Vp& __x)
+    {
+      using _Tp = typename _Vp::value_type;
+      constexpr int __m = sizeof...(_Sets);
+      constexpr int __nmax = [] {
+	int __n = 0;
+	((__n = std::max(__n, int(__poly_coeffs<_Tp, _Sets>().size()))), ...);
+	return __n;
+      }();
+      constexpr int __block
+	= _Block == 0 ? __poly_block_size<__nmax, __m>() : std::min(_Block, __nmax);
+      const array<_Vp, 1> __xs = {__x};
+      const auto __y = __poly_powers<__block, __poly_levels<__nmax, __block>()>(__xs);
+      array<_Vp, __m> __r;
+      template for (constexpr int __s : _IotaArray<__m>)
+	{
+	  constexpr auto __c = __poly_coeffs<_Tp, _Sets...[__s]>();
+	  constexpr int __n = __c.size();
+	  static_assert(__n > 0, "a polynomial needs at least one coefficient");
+	  __r[__s] = __poly_eval<std::min(__block, __n), _Vp>(__c, __xs, __y)[0];
+	}
+      return __r;
+    }
+
+  /** @brief Evaluates the polynomial c0 + c1 x + c2 x² + … for every element of @p __x.
+   *
+   * The coefficients are given as template arguments, either as a list of scalars (e.g.
+   * @c polynomial<1., 1., .5>(x)) or as a single constexpr array (lowest order first). They are
+   * converted to the value type of @p __x.
+   *
+   * The evaluation scheme is chosen at compile time from the degree and the number of inputs:
+   * Horner's scheme where the inputs alone suffice to keep the FMA pipes busy, otherwise a hybrid
+   * of Horner and Estrin (see horner and estrin for forcing either).
+   *
+   * With more than one argument, the same polynomial is evaluated on all of them in a single
+   * interleaved pass and the results are returned as an array (use structured bindings).
+   */
+  template <auto... _Coeffs, __simd_floating_point _Vp, same_as<_Vp>... _Vps>
+    requires (!__poly_coeff_sets<_Coeffs...>)
+    [[__gnu__::__always_inline__]]
+    constexpr auto
+    polynomial(const _Vp& __x, const _Vps&... __xs)
+    { return __poly_apply<0, _Coeffs...>(__x, __xs...); }
+
+  /** @brief Evaluates several polynomials, given as constexpr coefficient arrays, on @p __x.
+   *
+   * E.g. @c polynomial<sin_coeffs, cos_coeffs>(x) evaluates both polynomials and returns their
+   * results as an array (use structured bindings). Since the polynomials are independent, fewer
+   * Estrin steps are needed to keep the FMA pipes busy than for evaluating them one after the
+   * other, and the powers of x these steps need are computed once for all polynomials.
+   */
+  template <auto... _Sets, __simd_floating_point _Vp>
+    requires __poly_coeff_sets<_Sets...>
+    [[__gnu__::__always_inline__]]
+    constexpr array<_Vp, sizeof...(_Sets)>
+    polynomial(const _Vp& __x)
+    { return __poly_apply_sets<0, _Sets...>(__x); }
+
+  /** @brief Same as polynomial, but always uses Horner's scheme.
+   *
+   * This needs the fewest operations and is therefore best in throughput-bound loops.
+   */
+  template <auto... _Coeffs, __simd_floating_point _Vp, same_as<_Vp>... _Vps>
+    [[__gnu__::__always_inline__]]
+    constexpr auto
+    horner(const _Vp& __x, const _Vps&... __xs)
+    { return __poly_apply<numeric_limits<int>::max(), _Coeffs...>(__x, __xs...); }
+
+  /** @brief Same as polynomial, but always uses Estrin's scheme.
+   *
+   * This has the shortest dependency chain (logarithmic in the degree) and is therefore best for
+   * latency-bound evaluation of a single vector.
+   */
+  template <auto... _Coeffs, __simd_floating_point _Vp, same_as<_Vp>... _Vps>
+    [[__gnu__::__always_inline__]]
+    constexpr auto
+    estrin(const _Vp& __x, const _Vps&... __xs)
+    { return __poly_apply<2, _Coeffs...>(__x, __xs...); }
+} // namespace simd
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+#endif // VIR_EXTENSIONS
+
+#pragma GCC diagnostic pop
+#endif // C++26
+#endif // _GLIBCXX_SIMD_POLYNOMIAL_H
@@ -228,6 +228,120 @@ namespace simd
     inline constexpr _Tp __max_shift
       = (sizeof(_Tp) < sizeof(int) ? sizeof(int) : sizeof(_Tp)) * __CHAR_BIT__;
 
+  /** @internal
+   * Shuffle indices for compress and expand of @p _Np ≤ 8 elements, indexed by the selector
+   * bitmask.
+   *
+   * _M_compress[k]: the positions of the set bits of k in ascending order (identity for the
+   * remaining elements).
+   * _M_expand[k][i]: the number of set bits in k below bit i.
+   */
+  template <int _Np>
+    struct _CompressLut
+    {
+      unsigned char _M_compress[1 << _Np][_Np];
+      unsigned char _M_expand[1 << _Np][_Np];
+    };
+
+  template <int _Np>
+    inline constexpr _CompressLut<_Np> __compress_lut = [] {
+      static_assert(_Np >= 2 && _Np <= 8);
+      _CompressLut<_Np> __r = {};
+      for (unsigned __k = 0; __k < (1u << _Np); ++__k)
+	{
+	  int __j = 0;
+	  for (int __i = 0; __i < _Np; ++__i)
+	    {
+	      __r._M_expand[__k][__i] = __j;
+	      if ((__k >> __i) & 1)
+		__r._M_compress[__k][__j++] = __i;
+	    }
+	  for (int __i = __j; __i < _Np; ++__i)
+	    __r._M_compress[__k][__i] = __i;
+	}
+      return __r;
+    }();
+
+  /** @internal
+   * Returns the shuffle indices for compress (@p _Expand = false) or expand of @p _Np elements
+   * according to the selector bitmask @p __bits.
+   *
+   * More than 8 elements are processed in groups of 8. For expand, the indices are offset by the
+   * number of elements consumed by the preceding groups. For compress, every group is only
+   * compressed within itself; the caller needs to concatenate the groups.
+   */
+  template <int _Np, bool _Expand>
+    [[__gnu__::__always_inline__]]
+    inline __vec_builtin_type<unsigned char, _Np>
+    __compress_indices(unsigned long long __bits)
+    {
+      using _UV = __vec_builtin_type<unsigned char, _Np>;
+      if constexpr (_Np <= 8)
+	{
+	  const auto& __lut = __compress_lut<_Np>;
+	  _UV __r;
+	  __builtin_memcpy(&__r, _Expand ? __lut._M_expand[__bits] : __lut._M_compress[__bits],
+			   _Np);
+	  return __r;
+	}
+      else
+	{
+	  constexpr unsigned long long __ones = 0x0101'0101'0101'0101ull;
+	  const auto& __lut = __compress_lut<8>;
+	  unsigned char __buf[_Np];
+	  unsigned long long __offset = 0;
+	  template for (constexpr int __g : _IotaArray<_Np / 8>)
+	    {
+	      const unsigned __kg = (__bits >> (8 * __g)) & 0xff;
+	      unsigned long long __row;
+	      if constexpr (_Expand)
+		{
+		  __builtin_memcpy(&__row, __lut._M_expand[__kg], 8);
+		  __row += __offset * __ones;
+		  __offset += __builtin_popcount(__kg);
+		}
+	      else
+		{
+		  __builtin_memcpy(&__row, __lut._M_compress[__kg], 8);
+		  __row += 8 * __g * __ones;
+		}
+	      __builtin_memcpy(__buf + 8 * __g, &__row, 8);
+	    }
+	  return __builtin_bit_cast(_UV, __buf);
+	}
+    }
+
+  /** @internal
+   * Element-wise implementation of compress for constant evaluation.
+   */
+  template <typename _Vp>
+    constexpr _Vp
+    __compress_generic(const _Vp& __v, const typename _Vp::mask_type& __k, const _Vp& __fill)
+    {
+      typename _Vp::value_type __tmp[_Vp::size()];
+      int __j = 0;
+      for (int __i = 0; __i < _Vp::size(); ++__i)
+	if (__k[__i])
+	  __tmp[__j++] = __v[__i];
+      for (; __j < _Vp::size(); ++__j)
+	__tmp[__j] = __fill[__j];
+      return _Vp([&](int __i) { return __tmp[__i]; });
+    }
+
+  /** @internal
+   * Element-wise implementation of expand for constant evaluation.
+   */
+  template <typename _Vp>
+    constexpr _Vp
+    __expand_generic(const _Vp& __v, const typename _Vp::mask_type& __k, const _Vp& __orig)
+    {
+      typename _Vp::value_type __tmp[_Vp::size()];
+      int __j = 0;
+      for (int __i = 0; __i < _Vp::size(); ++__i)
+	__tmp[__i] = __k[__i] ? __v[__j++] : __orig[__i];
+      return _Vp([&](int __i) { return __tmp[__i]; });
+    }
+
   template <__vectorizable _Tp, __abi_tag _Ap>
     requires (_Ap::_S_nreg == 1)
       && (!__complex_like<_Tp>)
@@ -864,6 +978,24 @@ namespace simd
 		return __select_impl(mask_type::_S_partial_mask_of_n(int(__n)),
 				     basic_vec(_LoadCtorTag(), __mem), basic_vec());
 #endif
+	      // Allow an out-of-bounds read if it stays within the page of __mem[0], which is
+	      // readable because __n > 0. Only tails that cross a page boundary (about
+	      // sizeof(_DataType) / 4096 of all addresses) need the slow paths below.
+	      else if (__allow_overread && __n > 0
+			 && __read_stays_within_page<sizeof(_DataType)>(__mem)) [[likely]]
+		{
+		  // A vector load via a may_alias type instead of memcpy, which would tell the
+		  // compiler that the object at __mem is sizeof(_DataType) bytes large. The read is
+		  // out of bounds of the object in terms of the C++ abstract machine (though not of
+		  // the hardware). The empty asm hides the origin of the pointer, so that the
+		  // compiler cannot see the bounds of the object and must emit the load as is.
+		  using _AliasT [[__gnu__::__may_alias__, __gnu__::__aligned__(alignof(_Up))]]
+		    = _DataType;
+		  const _AliasT* __ptr = reinterpret_cast<const _AliasT*>(__mem);
+		  asm("" : "+r"(__ptr));
+		  return __select_impl(mask_type::_S_partial_mask_of_n(int(__n)), basic_vec(*__ptr),
+				       basic_vec());
+		}
 	      else if constexpr (_S_size > 4)
 		{
 		  alignas(_DataType) byte __dst[sizeof(_DataType)] = {};
@@ -947,6 +1079,62 @@ namespace simd
 	    }
 	}
 
+      /** @internal
+       * Implementation of @ref unchecked_gather_from.
+       *
+       * @param __mem  Pointer to the first element of the range.
+       * @param __idx  Indices into @p __mem (a basic_vec of integers with the same size).
+       * @param __k    Only elements where @p __k is set are read; all other elements are zero.
+       *               Indices of elements where @p __k is set must be in bounds.
+       */
+      template <typename _Up, typename _IV, _ArchTraits _Traits = {}>
+	static inline basic_vec
+	_S_gather(const _Up* __mem, const _IV& __idx, mask_type __k)
+	{
+#if _GLIBCXX_X86
+	  // vgather* takes signed 32- or 64-bit indices
+	  using _It = typename _IV::value_type;
+	  using _Ip = conditional_t<(sizeof(_It) < 4 || (sizeof(_It) == 4 && is_signed_v<_It>)),
+				    int, long long>;
+	  using _IpV = rebind_t<_Ip, basic_vec>;
+	  constexpr bool __have_gather
+	    = _Traits._M_have_avx2() && (sizeof(_Up) == 4 || sizeof(_Up) == 8);
+#endif
+	  if constexpr (_S_size == 1)
+	    return __k[0] ? static_cast<value_type>(__mem[__idx[0]]) : value_type();
+#if _GLIBCXX_X86
+	  else if constexpr (__have_gather && !__converts_trivially<_Up, value_type>)
+	    {
+	      using _UV = rebind_t<_Up, basic_vec>;
+	      return basic_vec(_UV::_S_gather(__mem, __idx, typename _UV::mask_type(__k)));
+	    }
+	  else if constexpr (__have_gather && _IpV::abi_type::_S_nreg == 1)
+	    {
+	      if constexpr (_S_is_partial) // never read at the indices of the padding elements
+		__k = __k && mask_type::_S_init(mask_type::_S_implicit_mask);
+	      return __x86_gather<_DataType>(__mem, _IpV(__idx)._M_get(), __k._M_data);
+	    }
+#endif
+	  else if (__is_const_known_equal_to(__k._M_all_of(), true))
+	    {
+	      constexpr auto [...__is] = _IotaArray<_S_size>;
+	      return _DataType{static_cast<value_type>(__mem[__idx[__is]])...};
+	    }
+	  else if (__k._M_none_of()) [[unlikely]]
+	    return basic_vec();
+	  else
+	    {
+	      // Use at least 4-byte __bits in __bit_foreach for better code-gen
+	      _Bitmask<_S_size < 32 ? 32 : _S_size> __bits = __k._M_to_uint();
+	      [[assume(__bits != 0)]]; // because of '__k._M_none_of()' branch above
+	      _DataType __r = {};
+	      __bit_foreach(__bits, [&] [[__gnu__::__always_inline__]] (int __i) {
+		__r[__i] = static_cast<value_type>(__mem[__idx[__i]]);
+	      });
+	      return __r;
+	    }
+	}
+
       template <typename _Up>
 	[[__gnu__::__always_inline__]]
 	inline void
@@ -980,6 +1168,14 @@ namespace simd
 					     : mask_type(true);
 	      return _S_masked_store(__v, __mem, __k);
 	    }
+	  else if constexpr (_Traits._M_have_avx() && (sizeof(_Up) == 4 || sizeof(_Up) == 8)
+			       && !_S_is_scalar)
+	    { // vmaskmovps/pd or vpmaskmovd/q instead of a chain of smaller stores
+	      if (__n >= _S_size) [[unlikely]]
+		__v._M_store(__mem);
+	      else
+		_S_masked_store(__v, __mem, mask_type::_S_partial_mask_of_n(int(__n)));
+	    }
 #endif
 	  else if (__n >= _S_size) [[unlikely]]
 	    __v._M_store(__mem);
@@ -1075,6 +1271,112 @@ namespace simd
 	    }
 	}
 
+#if VIR_EXTENSIONS
+      /** @internal
+       * Implementation of unchecked_store with @ref __flag_streaming: a non-temporal store if
+       * @p __mem is aligned to the register size, otherwise a regular store.
+       */
+      template <typename _Up, _ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static inline void
+	_S_streaming_store(const basic_vec& __v, _Up* __mem)
+	{
+#if _GLIBCXX_X86
+	  if constexpr (!_S_is_scalar && !_S_is_partial && __converts_trivially<value_type, _Up>
+			  && (sizeof(_DataType) == 16
+				|| (sizeof(_DataType) == 32 && _Traits._M_have_avx())
+				|| (sizeof(_DataType) == 64 && _Traits._M_have_avx512f())))
+	    {
+	      if (is_sufficiently_aligned<sizeof(_DataType)>(__mem))
+		{
+		  __x86_stream_store(__v._M_data, __mem);
+		  return;
+		}
+	    }
+#endif
+	  __v._M_store(__mem);
+	}
+
+      /** @internal
+       * Implementation of unchecked_load with @ref __flag_streaming: a non-temporal load
+       * (movntdqa) if @p __mem is aligned to the register size, otherwise a regular load.
+       */
+      template <typename _Up, _ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static inline basic_vec
+	_S_streaming_load(const _Up* __mem)
+	{
+#if _GLIBCXX_X86
+	  if constexpr (!_S_is_scalar && !_S_is_partial && __converts_trivially<_Up, value_type>
+			  && ((sizeof(_DataType) == 16 && _Traits._M_have_sse4_1())
+				|| (sizeof(_DataType) == 32 && _Traits._M_have_avx2())
+				|| (sizeof(_DataType) == 64 && _Traits._M_have_avx512f())))
+	    {
+	      if (is_sufficiently_aligned<sizeof(_DataType)>(__mem))
+		return __x86_stream_load<_DataType>(__mem);
+	    }
+#endif
+	  return basic_vec(_LoadCtorTag(), __mem);
+	}
+#endif
+
+      /** @internal
+       * Implementation of @ref unchecked_scatter_to.
+       *
+       * @param __v    Values to store.
+       * @param __mem  Pointer to the first element of the range.
+       * @param __idx  Indices into @p __mem (a basic_vec of integers with the same size).
+       * @param __k    Only elements where @p __k is set are stored. Indices of elements where
+       *               @p __k is set must be in bounds.
+       *
+       * If several elements have the same index, the element with the highest index in @p __v
+       * is stored.
+       */
+      template <typename _Up, typename _IV, _ArchTraits _Traits = {}>
+	static inline void
+	_S_scatter(const basic_vec& __v, _Up* __mem, const _IV& __idx, mask_type __k)
+	{
+#if _GLIBCXX_X86
+	  // vscatter* takes signed 32- or 64-bit indices
+	  using _It = typename _IV::value_type;
+	  using _Ip = conditional_t<(sizeof(_It) < 4 || (sizeof(_It) == 4 && is_signed_v<_It>)),
+				    int, long long>;
+	  using _IpV = rebind_t<_Ip, basic_vec>;
+	  constexpr bool __have_scatter
+	    = _Traits._M_have_avx512f() && (sizeof(_Up) == 4 || sizeof(_Up) == 8);
+#endif
+	  if constexpr (_S_size == 1)
+	    {
+	      if (__k[0])
+		__mem[__idx[0]] = static_cast<_Up>(__v[0]);
+	    }
+#if _GLIBCXX_X86
+	  else if constexpr (__have_scatter && !__converts_trivially<value_type, _Up>)
+	    {
+	      using _UV = rebind_t<_Up, basic_vec>;
+	      _UV::_S_scatter(_UV(__v), __mem, __idx, typename _UV::mask_type(__k));
+	    }
+	  else if constexpr (__have_scatter && _IpV::abi_type::_S_nreg == 1)
+	    {
+	      if constexpr (_S_is_partial) // never write at the indices of the padding elements
+		__k = __k && mask_type::_S_init(mask_type::_S_implicit_mask);
+	      __x86_scatter(__v._M_data, __mem, _IpV(__idx)._M_get(), __k._M_data);
+	    }
+#endif
+	  else if (__k._M_none_of()) [[unlikely]]
+	    return;
+	  else
+	    {
+	      // Use at least 4-byte __bits in __bit_foreach for better code-gen
+	      _Bitmask<_S_size < 32 ? 32 : _S_size> __bits = __k._M_to_uint();
+	      [[assume(__bits != 0)]]; // because of '__k._M_none_of()' branch above
+	      // __bit_foreach visits the lowest bit first, thus the last store of an index wins
+	      __bit_foreach(__bits, [&] [[__gnu__::__always_inline__]] (int __i) {
+		__mem[__idx[__i]] = static_cast<_Up>(__v[__i]);
+	      });
+	    }
+	}
+
 #if VIR_PATCH_MATH
       [[__gnu__::__always_inline__]]
       inline basic_vec
@@ -1442,6 +1744,155 @@ namespace simd
 	}
 #endif
 
+      // [simd.permute.mask] --------------------------------------------------
+      /** @internal
+       * Implementation of @ref compress: the elements of @p __v where @p __k is set, in order,
+       * followed by unspecified values.
+       *
+       * AVX-512 uses vcompress*. Otherwise a dynamic shuffle with indices from a LUT does the
+       * work (vpermps, pshufb, ...). More than 8 elements are compressed in groups of 8, which
+       * are then concatenated in memory.
+       */
+      template <_ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_compress(const basic_vec& __v, const mask_type& __k)
+	{
+	  if constexpr (_S_is_scalar)
+	    return __v;
+	  else
+	    {
+	      if consteval
+		{
+		  return __compress_generic(__v, __k, __v);
+		}
+#if _GLIBCXX_X86
+	      if constexpr (_S_use_bitmask
+			      && (sizeof(value_type) >= 4 || _Traits._M_have_avx512vbmi2()))
+		return __x86_compress_expand<false>(__v._M_data, __v._M_data,
+						    __k._M_data & mask_type::_S_implicit_mask);
+	      else
+#endif
+		{
+		  using _IV = __vec_builtin_type<_UInt<sizeof(value_type)>, _S_full_size>;
+		  const auto __bits = __k._M_to_uint();
+		  const auto __idx = __compress_indices<_S_full_size, false>(__bits);
+		  const _DataType __r = __vec_shuffle(__v._M_data, __vec_cast<_IV>(__idx));
+		  if constexpr (_S_full_size <= 8)
+		    return __r;
+		  else
+		    {
+		      // store every group of 8 elements right after the selected elements of the
+		      // previous groups
+		      constexpr size_t __group_bytes = 8 * sizeof(value_type);
+		      const char* __src = reinterpret_cast<const char*>(&__r);
+		      value_type __buf[_S_full_size];
+		      __builtin_memcpy(__buf, __src, sizeof(__r));
+		      int __offset = __builtin_popcount(__bits & 0xff);
+		      template for (constexpr int __g : _IotaArray<_S_full_size / 8 - 1>)
+			{
+			  __builtin_memcpy(__buf + __offset, __src + (__g + 1) * __group_bytes,
+					   __group_bytes);
+			  __offset += __builtin_popcount((__bits >> (8 * __g + 8)) & 0xff);
+			}
+		      return __builtin_bit_cast(_DataType, __buf);
+		    }
+		}
+	    }
+	}
+
+      /** @internal
+       * Implementation of @ref compress with a fill value: as above, but the elements after the
+       * selected elements are copied from @p __fill.
+       */
+      template <_ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_compress(const basic_vec& __v, const mask_type& __k, const basic_vec& __fill)
+	{
+	  if constexpr (_S_is_scalar)
+	    return __k[0] ? __v : __fill;
+	  else
+	    {
+	      if consteval
+		{
+		  return __compress_generic(__v, __k, __fill);
+		}
+#if _GLIBCXX_X86
+	      if constexpr (_S_use_bitmask
+			      && (sizeof(value_type) >= 4 || _Traits._M_have_avx512vbmi2()))
+		return __x86_compress_expand<false>(__v._M_data, __fill._M_data,
+						    __k._M_data & mask_type::_S_implicit_mask);
+	      else
+#endif
+		return __select_impl(mask_type::_S_partial_mask_of_n(__k._M_reduce_count()),
+				     _S_compress(__v, __k), __fill);
+	    }
+	}
+
+      /** @internal
+       * Implementation of @ref expand: the elements of @p __v, in order, at the positions where
+       * @p __k is set; the elements of @p __orig elsewhere.
+       *
+       * AVX-512 uses vexpand*. Otherwise a dynamic shuffle with indices from a LUT does the work.
+       */
+      template <_ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_expand(const basic_vec& __v, const mask_type& __k, const basic_vec& __orig)
+	{
+	  if constexpr (_S_is_scalar)
+	    return __k[0] ? __v : __orig;
+	  else
+	    {
+	      if consteval
+		{
+		  return __expand_generic(__v, __k, __orig);
+		}
+#if _GLIBCXX_X86
+	      if constexpr (_S_use_bitmask
+			      && (sizeof(value_type) >= 4 || _Traits._M_have_avx512vbmi2()))
+		return __x86_compress_expand<true>(__v._M_data, __orig._M_data,
+						   __k._M_data & mask_type::_S_implicit_mask);
+	      else
+#endif
+		{
+		  using _IV = __vec_builtin_type<_UInt<sizeof(value_type)>, _S_full_size>;
+		  const auto __idx = __compress_indices<_S_full_size, true>(__k._M_to_uint());
+		  const basic_vec __r = __vec_shuffle(__v._M_data, __vec_cast<_IV>(__idx));
+		  return __select_impl(__k, __r, __orig);
+		}
+	    }
+	}
+
+#if VIR_EXTENSIONS
+      /** @internal
+       * Implementation of @ref compress_store: stores the elements of @p __v selected by @p __k
+       * contiguously to @p __mem and returns their number.
+       *
+       * If @p __full is true, @p __mem points to at least _S_size elements, which allows a full
+       * store of the compressed vector instead of a partial store.
+       */
+      template <typename _Up, _ArchTraits _Traits = {}>
+	static inline int
+	_S_compress_store(const basic_vec __v, _Up* __mem, const mask_type __k, bool __full)
+	{
+	  const int __n = __k._M_reduce_count();
+#if _GLIBCXX_X86
+	  if constexpr (_S_use_bitmask && !_S_is_scalar && __converts_trivially<value_type, _Up>
+			  && (sizeof(value_type) >= 4 || _Traits._M_have_avx512vbmi2()))
+	    __x86_compress_store(__v._M_data, reinterpret_cast<value_type*>(__mem),
+				 __k._M_data & mask_type::_S_implicit_mask);
+	  else
+#endif
+	  if (__full)
+	    _S_compress(__v, __k)._M_store(__mem);
+	  else
+	    _S_partial_store(_S_compress(__v, __k), __mem, size_t(__n));
+	  return __n;
+	}
+#endif
+
       // [simd.unary] unary operators -----------------------------------------
       // increment and decrement are implemented in terms of operator+=/-= which avoids UB on
       // padding elements while not breaking UBsan
@@ -1710,6 +2161,25 @@ namespace simd
 		__y1 = __select_impl(mask_type::_S_init(mask_type::_S_implicit_mask),
 				     __y, basic_vec(value_type(1)));
 	    }
+#if _GLIBCXX_X86
+	  // With -freciprocal-math and approximate math, x * rcp(y) with one Newton step is
+	  // sufficient for float (about 2 ULP) and has a much higher throughput than divps.
+	  // rcpps flushes subnormal inputs and results, therefore divide if any |y| is outside of
+	  // [2^-126, 2^126) (which includes 0, inf, and NaN). The unsigned subtraction maps the
+	  // bits of that range to [0, 0x7e00'0000) and everything else above.
+	  if constexpr (is_same_v<value_type, float> && !_S_is_scalar
+			  && _Traits._M_reciprocal_math() && _Traits._M_approx_math())
+	    {
+	      constexpr unsigned __lo = __builtin_bit_cast(unsigned, 0x1p-126f);
+	      constexpr unsigned __hi = __builtin_bit_cast(unsigned, 0x1p126f);
+	      const auto __bits = __vec_bit_cast<unsigned>(__y1._M_data) & 0x7fff'ffffu;
+	      if (__x86_vec_is_zero(__bits - __lo >= __hi - __lo))
+		{
+		  __x._M_data *= __x86_rcp<1, true, _ArchTraits(_Traits)>(__y1._M_data);
+		  return __x;
+		}
+	    }
+#endif
 	  __x._M_data /= __y1._M_data;
 	  return __x;
 	}
@@ -2213,6 +2683,15 @@ namespace simd
 			 _DataType1::_S_masked_load(__mem + _N0, __k._M_data1));
 	}
 
+      template <typename _Up, typename _IV>
+	static inline basic_vec
+	_S_gather(const _Up* __mem, const _IV& __idx, mask_type __k)
+	{
+	  const auto [__i0, __i1] = chunk<_N0>(__idx);
+	  return _S_init(_DataType0::_S_gather(__mem, __i0, __k._M_data0),
+			 _DataType1::_S_gather(__mem, __i1, __k._M_data1));
+	}
+
       template <typename _Up>
 	[[__gnu__::__always_inline__]]
 	inline void
@@ -2247,6 +2726,36 @@ namespace simd
 	  _DataType1::_S_masked_store(__v._M_data1, __mem + _N0, __k._M_data1);
 	}
 
+#if VIR_EXTENSIONS
+      template <typename _Up>
+	[[__gnu__::__always_inline__]]
+	static inline void
+	_S_streaming_store(const basic_vec& __v, _Up* __mem)
+	{
+	  _DataType0::_S_streaming_store(__v._M_data0, __mem);
+	  _DataType1::_S_streaming_store(__v._M_data1, __mem + _N0);
+	}
+
+      template <typename _Up>
+	[[__gnu__::__always_inline__]]
+	static inline basic_vec
+	_S_streaming_load(const _Up* __mem)
+	{
+	  return _S_init(_DataType0::_S_streaming_load(__mem),
+			 _DataType1::_S_streaming_load(__mem + _N0));
+	}
+#endif
+
+      template <typename _Up, typename _IV>
+	static inline void
+	_S_scatter(const basic_vec& __v, _Up* __mem, const _IV& __idx, const mask_type& __k)
+	{
+	  const auto [__i0, __i1] = chunk<_N0>(__idx);
+	  // low before high: the highest element wins if indices collide
+	  _DataType0::_S_scatter(__v._M_data0, __mem, __i0, __k._M_data0);
+	  _DataType1::_S_scatter(__v._M_data1, __mem, __i1, __k._M_data1);
+	}
+
       basic_vec() = default;
 
       // [simd.overview] p2 impl-def conversions ------------------------------
@@ -2375,6 +2884,80 @@ namespace simd
 	}
 #endif
 
+      // [simd.permute.mask] --------------------------------------------------
+      /** @internal
+       * Compresses both halves and concatenates them in memory.
+       */
+      template <_ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_compress(const basic_vec& __v, const mask_type& __k)
+	{
+	  if consteval
+	    {
+	      return __compress_generic(__v, __k, __v);
+	    }
+	  else
+	    {
+	      const _DataType0 __lo = _DataType0::_S_compress(__v._M_data0, __k._M_data0);
+	      const _DataType1 __hi = _DataType1::_S_compress(__v._M_data1, __k._M_data1);
+	      value_type __buf[_S_size];
+	      __lo._M_store(__buf);
+	      __hi._M_store(__buf + _N0); // only to initialize the tail
+	      __hi._M_store(__buf + __k._M_data0._M_reduce_count());
+	      return basic_vec(_LoadCtorTag(), __buf);
+	    }
+	}
+
+      template <_ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_compress(const basic_vec& __v, const mask_type& __k, const basic_vec& __fill)
+	{
+	  if consteval
+	    {
+	      return __compress_generic(__v, __k, __fill);
+	    }
+	  else
+	    return __select_impl(mask_type::_S_partial_mask_of_n(__k._M_reduce_count()),
+				 _S_compress(__v, __k), __fill);
+	}
+
+      /** @internal
+       * Expands into both halves; the high half continues with the elements of @p __v that were
+       * not consumed by the low half.
+       */
+      template <_ArchTraits _Traits = {}>
+	[[__gnu__::__always_inline__]]
+	static constexpr basic_vec
+	_S_expand(const basic_vec& __v, const mask_type& __k, const basic_vec& __orig)
+	{
+	  if consteval
+	    {
+	      return __expand_generic(__v, __k, __orig);
+	    }
+	  else
+	    {
+	      value_type __buf[_S_size];
+	      __v._M_store(__buf);
+	      const _DataType1 __v1(_LoadCtorTag(), __buf + __k._M_data0._M_reduce_count());
+	      return _S_init(_DataType0::_S_expand(__v._M_data0, __k._M_data0, __orig._M_data0),
+			     _DataType1::_S_expand(__v1, __k._M_data1, __orig._M_data1));
+	    }
+	}
+
+#if VIR_EXTENSIONS
+      template <typename _Up>
+	static inline int
+	_S_compress_store(const basic_vec& __v, _Up* __mem, const mask_type& __k, bool __full)
+	{
+	  // with __full, the high half ends at most _N0 - __n0 elements before the end of __mem
+	  const int __n0 = _DataType0::_S_compress_store(__v._M_data0, __mem, __k._M_data0, __full);
+	  return __n0 + _DataType1::_S_compress_store(__v._M_data1, __mem + __n0, __k._M_data1,
+						      __full);
+	}
+#endif
+
       // [simd.unary] unary operators -----------------------------------------
       [[__gnu__::__always_inline__]]
       constexpr basic_vec&
@@ -424,7 +424,6 @@ namespace simd
 	    }
 	}
     }
-#if VIR_PATCH_PERMUTE_DYNAMIC
 
   // overload for 32/64/128-bit pshufb without OpenCL modulo semantics
   template <__vec_builtin _TV, __vec_builtin _IV, _ArchTraits _Traits = {}>
@@ -526,7 +525,6 @@ namespace simd
 						   : (__perm > 15 ? __v1 : __v0));
 	}
     }
-#endif // VIR_PATCH_PERMUTE_DYNAMIC
 #endif // not Clang
 
   template <_X86Cmp _Cmp, __vec_builtin _TV, _ArchTraits _Traits = {}>
@@ -957,6 +955,289 @@ namespace simd
 				__duplicate_each_bit<__in1>(__x._M_second) };
     }
 
+  /** @internal
+   * @brief Returns @p __a * @p __b - @p __c for even and @p __a * @p __b + @p __c for odd elements.
+   */
+  template <__vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_fmaddsub(_TV __a, _TV __b, _TV __c)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      static_assert(_Traits._M_have_fma());
+      static_assert(sizeof(_TV) >= 16);
+
+      if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmaddsubph128_mask(__a, __b, __c, -1);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmaddsubph256_mask(__a, __b, __c, -1);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmaddsubph512_mask(__a, __b, __c, -1, 0x04);
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 4)
+	return __builtin_ia32_vfmaddsubps(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 4)
+	return __builtin_ia32_vfmaddsubps256(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 4)
+	return __builtin_ia32_vfmaddsubps512_mask(__a, __b, __c, -1, 0x04);
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 8)
+	return __builtin_ia32_vfmaddsubpd(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 8)
+	return __builtin_ia32_vfmaddsubpd256(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 8)
+	return __builtin_ia32_vfmaddsubpd512_mask(__a, __b, __c, -1, 0x04);
+
+      else
+	static_assert(false);
+    }
+
+  /** @internal
+   * @brief Returns @p __a * @p __b + @p __c (or - @p __c if @p _Sub is true) for _Float16 vectors
+   * with a single rounding step.
+   *
+   * This does not depend on -ffp-contract, which is important for the FP16 complex
+   * multiplication where the unfused variant loses too many bits.
+   */
+  template <bool _Sub = false, __vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_fma_ph(_TV __a, _TV __b, _TV __c)
+    {
+      static_assert(_Traits._M_have_avx512fp16());
+      static_assert(is_same_v<__vec_value_type<_TV>, _Float16>);
+
+      if constexpr (sizeof(_TV) < 16)
+	return _VecOps<_TV>::_S_extract(__x86_fma_ph<_Sub>(__vec_zero_pad_to_16(__a),
+							   __vec_zero_pad_to_16(__b),
+							   __vec_zero_pad_to_16(__c)));
+      else if constexpr (sizeof(_TV) == 16 && _Sub)
+	return __builtin_ia32_vfmsubph128_mask(__a, __b, __c, -1);
+      else if constexpr (sizeof(_TV) == 32 && _Sub)
+	return __builtin_ia32_vfmsubph256_mask(__a, __b, __c, -1);
+      else if constexpr (sizeof(_TV) == 64 && _Sub)
+	return __builtin_ia32_vfmsubph512_mask(__a, __b, __c, -1, 0x04);
+      else if constexpr (sizeof(_TV) == 16)
+	return __builtin_ia32_vfmaddph128_mask(__a, __b, __c, -1);
+      else if constexpr (sizeof(_TV) == 32)
+	return __builtin_ia32_vfmaddph256_mask(__a, __b, __c, -1);
+      else if constexpr (sizeof(_TV) == 64)
+	return __builtin_ia32_vfmaddph512_mask(__a, __b, __c, -1, 0x04);
+      else
+	static_assert(false);
+    }
+
+  /** @internal
+   * @brief Returns @p __a * @p __b + @p __c for float and double vectors with a single rounding
+   * step.
+   *
+   * Like __x86_fma_ph, this does not depend on -ffp-contract. remquo relies on it to compute the
+   * exact remainder x - n·y.
+   */
+  template <__vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_fma(_TV __a, _TV __b, _TV __c)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      static_assert(_Traits._M_have_fma());
+
+      if constexpr (sizeof(_TV) < 16)
+	return _VecOps<_TV>::_S_extract(__x86_fma(__vec_zero_pad_to_16(__a),
+						  __vec_zero_pad_to_16(__b),
+						  __vec_zero_pad_to_16(__c)));
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 4)
+	return __builtin_ia32_vfmaddps(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 4)
+	return __builtin_ia32_vfmaddps256(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 4)
+	return __builtin_ia32_vfmaddps512_mask(__a, __b, __c, -1, 0x04);
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 8)
+	return __builtin_ia32_vfmaddpd(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 8)
+	return __builtin_ia32_vfmaddpd256(__a, __b, __c);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 8)
+	return __builtin_ia32_vfmaddpd512_mask(__a, __b, __c, -1, 0x04);
+
+      else
+	static_assert(false);
+    }
+
+  /** @internal
+   * Returns whether __x86_rcp_estimate and __x86_rsqrt_estimate support @p _TV. For double, only
+   * AVX-512 has estimate instructions. (An estimate in float would flush or overflow outside of
+   * float's range.)
+   */
+  template <__vec_builtin _TV, _ArchTraits _Traits = {}>
+    consteval bool
+    __x86_have_estimate()
+    {
+      return sizeof(__vec_value_type<_TV>) < 8 || sizeof(_TV) == 64
+	       || _Traits._M_have_avx512vl();
+    }
+
+  /** @internal
+   * @brief Returns the hardware estimate of 1 / @p __x.
+   *
+   * The relative error is at most 1.5 * 2^-12 (rcpps), 2^-14 (AVX-512 rcp14), or 2^-11 (rcpph).
+   * Subnormal inputs and results may be flushed to zero. There is no estimate for double vectors
+   * without AVX-512 (see __x86_have_estimate).
+   */
+  template <__vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_rcp_estimate(_TV __x)
+    {
+      using _Tp = __vec_value_type<_TV>;
+
+      if constexpr (sizeof(_TV) < 16)
+	return _VecOps<_TV>::_S_extract(__x86_rcp_estimate(__vec_zero_pad_to_16(__x)));
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 2)
+	return __builtin_ia32_rcpph128_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 2)
+	return __builtin_ia32_rcpph256_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 2)
+	return __builtin_ia32_rcpph512_mask(__x, _TV(), -1);
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 4 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rcp14ps128_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 4 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rcp14ps256_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 4)
+	return __builtin_ia32_rcpps(__x);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 4)
+	return __builtin_ia32_rcpps256(__x);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 4)
+	return __builtin_ia32_rcp14ps512_mask(__x, _TV(), -1);
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 8 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rcp14pd128_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 8 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rcp14pd256_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 8)
+	return __builtin_ia32_rcp14pd512_mask(__x, _TV(), -1);
+
+      else
+	static_assert(false);
+    }
+
+  /** @internal
+   * @brief Returns the hardware estimate of 1 / sqrt(@p __x).
+   *
+   * The error bounds and caveats of __x86_rcp_estimate apply.
+   */
+  template <__vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_rsqrt_estimate(_TV __x)
+    {
+      using _Tp = __vec_value_type<_TV>;
+
+      if constexpr (sizeof(_TV) < 16)
+	return _VecOps<_TV>::_S_extract(__x86_rsqrt_estimate(__vec_zero_pad_to_16(__x)));
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 2)
+	return __builtin_ia32_rsqrtph128_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 2)
+	return __builtin_ia32_rsqrtph256_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 2)
+	return __builtin_ia32_rsqrtph512_mask(__x, _TV(), -1);
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 4 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rsqrt14ps128_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 4 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rsqrt14ps256_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 4)
+	return __builtin_ia32_rsqrtps(__x);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 4)
+	return __builtin_ia32_rsqrtps256(__x);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 4)
+	return __builtin_ia32_rsqrt14ps512_mask(__x, _TV(), -1);
+
+      else if constexpr (sizeof(_TV) == 16 && sizeof(_Tp) == 8 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rsqrt14pd128_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 32 && sizeof(_Tp) == 8 && _Traits._M_have_avx512vl())
+	return __builtin_ia32_rsqrt14pd256_mask(__x, _TV(), -1);
+      else if constexpr (sizeof(_TV) == 64 && sizeof(_Tp) == 8)
+	return __builtin_ia32_rsqrt14pd512_mask(__x, _TV(), -1);
+
+      else
+	static_assert(false);
+    }
+
+  /** @internal
+   * @brief Returns 1 / @p __x, refined from the hardware estimate with @p _Steps Newton-Raphson
+   * iterations.
+   *
+   * Every step doubles the number of correct bits (up to the rounding error of the step itself).
+   * Where the refinement produces NaN (for ±0 and ±inf) the estimate is returned, which is
+   * correct. With @p _Finite that fix-up is skipped. Without an estimate instruction the result is
+   * 1 / @p __x.
+   */
+  template <int _Steps, bool _Finite, _ArchTraits _Traits = {}, __vec_builtin _TV>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_rcp(_TV __x)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      if constexpr (!__x86_have_estimate<_TV, _Traits>())
+	return _Tp(1) / __x;
+      else
+	{
+	  const _TV __r0 = __x86_rcp_estimate<_TV, _Traits>(__x);
+	  _TV __r = __r0;
+	  for (int __i = 0; __i < _Steps; ++__i)
+	    __r += __r * (_Tp(1) - __x * __r);
+	  if constexpr (_Steps == 0 || _Finite)
+	    return __r;
+	  else
+	    return __r == __r ? __r : __r0;
+	}
+    }
+
+  /** @internal
+   * @brief Returns 1 / sqrt(@p __x), refined from the hardware estimate with @p _Steps
+   * Newton-Raphson iterations.
+   *
+   * Same as __x86_rcp, the estimate is returned for +0 and +inf unless @p _Finite is true.
+   * Without an estimate instruction the result is 1 / sqrt(@p __x).
+   */
+  template <int _Steps, bool _Finite, _ArchTraits _Traits = {}, __vec_builtin _TV>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_rsqrt(_TV __x)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      if constexpr (sizeof(_TV) < 16 && !__x86_have_estimate<_TV, _Traits>())
+	return _VecOps<_TV>::_S_extract(__x86_rsqrt<_Steps, _Finite, _Traits>(
+					  __vec_zero_pad_to_16(__x)));
+      else if constexpr (sizeof(_TV) == 16 && !__x86_have_estimate<_TV, _Traits>())
+	return _Tp(1) / __builtin_ia32_sqrtpd(__x);
+      else if constexpr (sizeof(_TV) == 32 && !__x86_have_estimate<_TV, _Traits>())
+	return _Tp(1) / __builtin_ia32_sqrtpd256(__x);
+      else
+	{
+	  const _TV __r0 = __x86_rsqrt_estimate<_TV, _Traits>(__x);
+	  const _TV __h = __x * _Tp(.5);
+	  _TV __r = __r0;
+	  for (int __i = 0; __i < _Steps; ++__i)
+	    __r *= _Tp(1.5) - __h * __r * __r;
+	  if constexpr (_Steps == 0 || _Finite)
+	    return __r;
+	  else
+	    return __r == __r ? __r : __r0;
+	}
+    }
+
+  /** @internal
+   * @brief Complex multiplication of interleaved (re, im) vectors.
+   *
+   * With AVX512FP16 the complex<_Float16> case is a single vfmulcph instruction. Otherwise the
+   * multiplication uses two shuffles, one multiplication and one fmaddsub.
+   */
   template <__vec_builtin _TV, _ArchTraits _Traits = {}>
     [[__gnu__::__always_inline__]]
     inline _TV
@@ -975,39 +1256,56 @@ namespace simd
 	return _VO::_S_extract(__x86_complex_multiplies(__vec_zero_pad_to_16(__x),
 							__vec_zero_pad_to_16(__y)));
 
+      else if constexpr (sizeof(__x) == 16 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmulcph128(__x, __y);
+      else if constexpr (sizeof(__x) == 32 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmulcph256(__x, __y);
+      else if constexpr (sizeof(__x) == 64 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmulcph512_round(__x, __y, 0x04);
+
       else
-	{
-	  _TV __x_real = _VO::_S_dup_even(__x);
-	  _TV __x_imag = _VO::_S_dup_odd(__x);
-	  _TV __y_swapped = _VO::_S_swap_neighbors(__y);
-
-	  if constexpr (sizeof(__x) == 16 && sizeof(_Tp) == 2)
-	    return __builtin_ia32_vfmaddsubph128_mask(__x_real, __y, __x_imag * __y_swapped, -1);
-	  else if constexpr (sizeof(__x) == 32 && sizeof(_Tp) == 2)
-	    return __builtin_ia32_vfmaddsubph256_mask(__x_real, __y, __x_imag * __y_swapped, -1);
-	  else if constexpr (sizeof(__x) == 64 && sizeof(_Tp) == 2)
-	    return __builtin_ia32_vfmaddsubph512_mask(
-		     __x_real, __y, __x_imag * __y_swapped, -1, 0x04);
-
-	  else if constexpr (sizeof(__x) == 16 && sizeof(_Tp) == 4)
-	    return __builtin_ia32_vfmaddsubps(__x_real, __y, __x_imag * __y_swapped);
-	  else if constexpr (sizeof(__x) == 32 && sizeof(_Tp) == 4)
-	    return __builtin_ia32_vfmaddsubps256(__x_real, __y, __x_imag * __y_swapped);
-	  else if constexpr (sizeof(__x) == 64 && sizeof(_Tp) == 4)
-	    return __builtin_ia32_vfmaddsubps512_mask(
-		     __x_real, __y, __x_imag * __y_swapped, -1, 0x04);
-
-	  else if constexpr (sizeof(__x) == 16 && sizeof(_Tp) == 8)
-	    return __builtin_ia32_vfmaddsubpd(__x_real, __y, __x_imag * __y_swapped);
-	  else if constexpr (sizeof(__x) == 32 && sizeof(_Tp) == 8)
-	    return __builtin_ia32_vfmaddsubpd256(__x_real, __y, __x_imag * __y_swapped);
-	  else if constexpr (sizeof(__x) == 64 && sizeof(_Tp) == 8)
-	    return __builtin_ia32_vfmaddsubpd512_mask(
-		     __x_real, __y, __x_imag * __y_swapped, -1, 0x04);
+	return __x86_fmaddsub(_VO::_S_dup_even(__x), __y,
+			      _VO::_S_dup_odd(__x) * _VO::_S_swap_neighbors(__y));
+    }
 
-	  else
-	    static_assert(false);
-	}
+  /** @internal
+   * @brief Complex multiply-add (@p __x * @p __y + @p __z) of interleaved (re, im) vectors.
+   *
+   * With AVX512FP16 the complex<_Float16> case is a single vfmaddcph instruction. Otherwise the
+   * addition is folded into two fmaddsub instructions:
+   * - even (real): x.re * y.re - (x.im * y.im - z.re)
+   * - odd (imag):  x.re * y.im + (x.im * y.re + z.im)
+   */
+  template <__vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_complex_fma(_TV __x, _TV __y, _TV __z)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      using _VO = _VecOps<_TV>;
+
+      static_assert(_Traits._M_have_fma());
+      static_assert(is_floating_point_v<_Tp>);
+
+      if constexpr (!_Traits._M_have_avx512fp16() && sizeof(_Tp) == 2)
+	return __vec_cast<_Tp>(__x86_complex_fma(__vec_cast<float>(__x), __vec_cast<float>(__y),
+						 __vec_cast<float>(__z)));
+      else if constexpr (sizeof(_TV) < 16)
+	return _VO::_S_extract(__x86_complex_fma(__vec_zero_pad_to_16(__x),
+						 __vec_zero_pad_to_16(__y),
+						 __vec_zero_pad_to_16(__z)));
+
+      else if constexpr (sizeof(__x) == 16 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmaddcph128(__x, __y, __z);
+      else if constexpr (sizeof(__x) == 32 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmaddcph256(__x, __y, __z);
+      else if constexpr (sizeof(__x) == 64 && sizeof(_Tp) == 2)
+	return __builtin_ia32_vfmaddcph512_round(__x, __y, __z, 0x04);
+
+      else
+	return __x86_fmaddsub(_VO::_S_dup_even(__x), __y,
+			      __x86_fmaddsub(_VO::_S_dup_odd(__x), _VO::_S_swap_neighbors(__y),
+					     __z));
     }
 
   // FIXME: Work around PR121688
@@ -1318,6 +1616,423 @@ namespace simd
 	}
     }
 
+  /** @internal
+   * AVX2 and AVX512 gathers: returns @p __mem[@p __idx[i]] for every i where @p __k is set, zero
+   * otherwise.
+   *
+   * @p __idx has 4- or 8-byte elements and the same number of elements as @p _TV. @p __k is
+   * either a bitmask (AVX512) or a vector mask (AVX2). Integers are gathered as float/double bit
+   * patterns.
+   *
+   * @note Without AVX512VL, 128- and 256-bit gathers use the 512-bit instructions with zero
+   * padded indices.
+   */
+  template <__vec_builtin _TV, typename _Up, __vec_builtin _IV, typename _Kp,
+	    _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_gather(const _Up* __mem, const _IV __idx, const _Kp __k)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      constexpr int __n = __width_of<_TV>;
+      constexpr int __isize = sizeof(__vec_value_type<_IV>);
+      static_assert(__converts_trivially<_Up, _Tp> && (sizeof(_Tp) == 4 || sizeof(_Tp) == 8));
+      static_assert(__width_of<_IV> == __n && (__isize == 4 || __isize == 8));
+      constexpr bool __bitmask = unsigned_integral<_Kp>;
+      static_assert(_Traits._M_have_avx2() && (!__bitmask || _Traits._M_have_avx512f()));
+      constexpr int __elsize = std::max(int(sizeof(_Tp)), __isize);
+      constexpr int __min_n = 16 / __elsize;
+      constexpr int __full_n = (__bitmask ? 64 : 32) / __elsize;
+      if constexpr (__n < __min_n || (__bitmask && !_Traits._M_have_avx512vl() && __n < __full_n))
+	{
+	  constexpr int __n2 = __bitmask && !_Traits._M_have_avx512vl() ? __full_n : __min_n;
+	  using _TV2 = __vec_builtin_type<_Tp, __n2>;
+	  const auto __idx2 = __vec_zero_pad_to<sizeof(_IV) * __n2 / __n>(__idx);
+	  if constexpr (__bitmask)
+	    return _VecOps<_TV>::_S_extract(__x86_gather<_TV2>(
+					      __mem, __idx2, unsigned(__k) & ((1u << __n) - 1)));
+	  else
+	    return _VecOps<_TV>::_S_extract(__x86_gather<_TV2>(
+					      __mem, __idx2,
+					      __vec_zero_pad_to<sizeof(_Kp) * __n2 / __n>(__k)));
+	}
+      else
+	{
+	  using _Fp = __float_from<sizeof(_Tp)>;
+	  using _Ip = conditional_t<__isize == 4, int, long long>;
+	  const auto* __base = reinterpret_cast<const _Fp*>(__mem);
+	  const auto __vi = [&] [[__gnu__::__always_inline__]] {
+	    if constexpr (sizeof(_IV) < 16) // 2 x int indices for 2 x double
+	      return __vec_zero_pad_to_16(__vec_bit_cast<_Ip>(__idx));
+	    else
+	      return __vec_bit_cast<_Ip>(__idx);
+	  }();
+	  // 8-byte indices for 4-byte elements return half a register
+	  const __vec_builtin_type<_Fp, std::max(__n, 16 / int(sizeof(_Tp)))> __z = {};
+	  const auto __r = [&] [[__gnu__::__always_inline__]] {
+	    constexpr int __s = sizeof(_Tp);
+	    if constexpr (__bitmask)
+	      {
+		if constexpr (__s == 4 && __isize == 4 && __n == 16)
+		  return __builtin_ia32_gathersiv16sf(__z, __base, __vi, __k, __s);
+		else if constexpr (__s == 4 && __isize == 4 && __n == 8)
+		  return __builtin_ia32_gather3siv8sf(__z, __base, __vi, __k, __s);
+		else if constexpr (__s == 4 && __isize == 4 && __n == 4)
+		  return __builtin_ia32_gather3siv4sf(__z, __base, __vi, __k, __s);
+		else if constexpr (__s == 4 && __n == 8)
+		  return __builtin_ia32_gatherdiv16sf(__z, __base, __vi, __k, __s);
+		else if constexpr (__s == 4 && __n == 4)
+		  return __builtin_ia32_gather3div8sf(__z, __base, __vi, __k, __s);
+		else if constexpr (__s == 4 && __n == 2)
+		  return __builtin_ia32_gather3div4sf(__z, __base, __vi, __k, __s);
+		else if constexpr (__isize == 4 && __n == 8)
+		  return __builtin_ia32_gathersiv8df(__z, __base, __vi, __k, __s);
+		else if constexpr (__isize == 4 && __n == 4)
+		  return __builtin_ia32_gather3siv4df(__z, __base, __vi, __k, __s);
+		else if constexpr (__isize == 4 && __n == 2)
+		  return __builtin_ia32_gather3siv2df(__z, __base, __vi, __k, __s);
+		else if constexpr (__n == 8)
+		  return __builtin_ia32_gatherdiv8df(__z, __base, __vi, __k, __s);
+		else if constexpr (__n == 4)
+		  return __builtin_ia32_gather3div4df(__z, __base, __vi, __k, __s);
+		else if constexpr (__n == 2)
+		  return __builtin_ia32_gather3div2df(__z, __base, __vi, __k, __s);
+		else
+		  static_assert(false);
+	      }
+	    else
+	      {
+		// the mask has the element size of the data, not of the indices
+		const auto __vk = __vec_bit_cast<_Fp>(__k);
+		if constexpr (__s == 4 && __isize == 4 && __n == 8)
+		  return __builtin_ia32_gathersiv8sf(__z, __base, __vi, __vk, __s);
+		else if constexpr (__s == 4 && __isize == 4 && __n == 4)
+		  return __builtin_ia32_gathersiv4sf(__z, __base, __vi, __vk, __s);
+		else if constexpr (__s == 4 && __n == 4)
+		  return __builtin_ia32_gatherdiv4sf256(__z, __base, __vi, __vk, __s);
+		else if constexpr (__s == 4 && __n == 2)
+		  return __builtin_ia32_gatherdiv4sf(__z, __base, __vi, __vec_zero_pad_to_16(__vk),
+						     __s);
+		else if constexpr (__isize == 4 && __n == 4)
+		  return __builtin_ia32_gathersiv4df(__z, __base, __vi, __vk, __s);
+		else if constexpr (__isize == 4 && __n == 2)
+		  return __builtin_ia32_gathersiv2df(__z, __base, __vi, __vk, __s);
+		else if constexpr (__n == 4)
+		  return __builtin_ia32_gatherdiv4df(__z, __base, __vi, __vk, __s);
+		else if constexpr (__n == 2)
+		  return __builtin_ia32_gatherdiv2df(__z, __base, __vi, __vk, __s);
+		else
+		  static_assert(false);
+	      }
+	  }();
+	  if constexpr (sizeof(__r) == sizeof(_TV))
+	    return reinterpret_cast<_TV>(__r);
+	  else
+	    return _VecOps<_TV>::_S_extract(__vec_bit_cast<_Tp>(__r));
+	}
+    }
+
+  /** @internal
+   * AVX512 compress (vcompressp*, vpcompress*) or expand (vexpandp*, vpexpand*) of @p __v
+   * according to the bitmask @p __k. Elements that are not written are copied from @p __src.
+   *
+   * @note 1- and 2-byte elements require AVX512VBMI2.
+   */
+  template <bool _Expand, __vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_compress_expand(const _TV __v, const _TV __src, unsigned_integral auto __k)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      constexpr int __n = __width_of<_TV>;
+      static_assert(_Traits._M_have_avx512f()
+		      && (sizeof(_Tp) >= 4 || _Traits._M_have_avx512vbmi2()));
+      if constexpr (sizeof(_TV) < 16 || (!_Traits._M_have_avx512vl() && sizeof(_TV) < 64))
+	{
+	  constexpr size_t __bytes = _Traits._M_have_avx512vl() ? 16 : 64;
+	  const auto __k2 = static_cast<unsigned long long>(__k) & (~0ull >> (64 - __n));
+	  return _VecOps<_TV>::_S_extract(
+		   __x86_compress_expand<_Expand>(__vec_zero_pad_to<__bytes>(__v),
+						  __vec_zero_pad_to<__bytes>(__src), __k2));
+	}
+      else
+	{
+	  // compress and expand only move data, thus 4- and 8-byte integers can use the FP variants
+	  using _Up = conditional_t<sizeof(_Tp) >= 4, __float_from<sizeof(_Tp)>,
+				    __x86_intrin_int<_Tp>>;
+	  const auto __x = __vec_bit_cast<_Up>(__v);
+	  const auto __s = __vec_bit_cast<_Up>(__src);
+	  constexpr int __bytes = sizeof(_TV);
+	  if constexpr (_Expand)
+	    {
+	      if constexpr (sizeof(_Tp) == 4 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandsf512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 4 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandsf256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 4 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandsf128_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 8 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_expanddf512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 8 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_expanddf256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 8 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_expanddf128_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 2 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandhi512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 2 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandhi256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 2 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandhi128_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 1 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandqi512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 1 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandqi256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 1 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_expandqi128_mask(__x, __s, __k));
+	      else
+		static_assert(false);
+	    }
+	  else
+	    {
+	      if constexpr (sizeof(_Tp) == 4 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_compresssf512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 4 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_compresssf256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 4 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_compresssf128_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 8 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_compressdf512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 8 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_compressdf256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 8 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_compressdf128_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 2 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_compresshi512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 2 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_compresshi256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 2 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_compresshi128_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 1 && __bytes == 64)
+		return reinterpret_cast<_TV>(__builtin_ia32_compressqi512_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 1 && __bytes == 32)
+		return reinterpret_cast<_TV>(__builtin_ia32_compressqi256_mask(__x, __s, __k));
+	      else if constexpr (sizeof(_Tp) == 1 && __bytes == 16)
+		return reinterpret_cast<_TV>(__builtin_ia32_compressqi128_mask(__x, __s, __k));
+	      else
+		static_assert(false);
+	    }
+	}
+    }
+
+  /** @internal
+   * AVX512 compress store (vcompressp*, vpcompress* with memory operand): stores the elements of
+   * @p __v where @p __k is set contiguously to @p __mem. Nothing after the last stored element is
+   * written.
+   *
+   * @note 1- and 2-byte elements require AVX512VBMI2.
+   */
+  template <__vec_builtin _TV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline void
+    __x86_compress_store(const _TV __v, __vec_value_type<_TV>* __mem, unsigned_integral auto __k)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      constexpr int __n = __width_of<_TV>;
+      static_assert(_Traits._M_have_avx512f()
+		      && (sizeof(_Tp) >= 4 || _Traits._M_have_avx512vbmi2()));
+      if constexpr (sizeof(_TV) < 16 || (!_Traits._M_have_avx512vl() && sizeof(_TV) < 64))
+	{
+	  constexpr size_t __bytes = _Traits._M_have_avx512vl() ? 16 : 64;
+	  const auto __k2 = static_cast<unsigned long long>(__k) & (~0ull >> (64 - __n));
+	  __x86_compress_store(__vec_zero_pad_to<__bytes>(__v), __mem, __k2);
+	}
+      else
+	{
+	  using _Up = conditional_t<sizeof(_Tp) >= 4, __float_from<sizeof(_Tp)>,
+				    __x86_intrin_int<_Tp>>;
+	  const auto __x = __vec_bit_cast<_Up>(__v);
+	  auto* __dst = reinterpret_cast<decltype(__x)*>(__mem);
+	  constexpr int __bytes = sizeof(_TV);
+	  if constexpr (sizeof(_Tp) == 4 && __bytes == 64)
+	    __builtin_ia32_compressstoresf512_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 4 && __bytes == 32)
+	    __builtin_ia32_compressstoresf256_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 4 && __bytes == 16)
+	    __builtin_ia32_compressstoresf128_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 8 && __bytes == 64)
+	    __builtin_ia32_compressstoredf512_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 8 && __bytes == 32)
+	    __builtin_ia32_compressstoredf256_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 8 && __bytes == 16)
+	    __builtin_ia32_compressstoredf128_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 2 && __bytes == 64)
+	    __builtin_ia32_compressstoreuhi512_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 2 && __bytes == 32)
+	    __builtin_ia32_compressstoreuhi256_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 2 && __bytes == 16)
+	    __builtin_ia32_compressstoreuhi128_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 1 && __bytes == 64)
+	    __builtin_ia32_compressstoreuqi512_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 1 && __bytes == 32)
+	    __builtin_ia32_compressstoreuqi256_mask(__dst, __x, __k);
+	  else if constexpr (sizeof(_Tp) == 1 && __bytes == 16)
+	    __builtin_ia32_compressstoreuqi128_mask(__dst, __x, __k);
+	  else
+	    static_assert(false);
+	}
+    }
+
+  /** @internal
+   * AVX512 scatters: stores @p __v[i] to @p __mem[@p __idx[i]] for every i where @p __k is set.
+   *
+   * @p __idx has 4- or 8-byte elements and the same number of elements as @p _TV. Integers are
+   * scattered as float/double bit patterns. If indices collide, the highest element wins.
+   *
+   * @note Without AVX512VL, 128- and 256-bit scatters use the 512-bit instructions with zero
+   * padded indices.
+   */
+  template <__vec_builtin _TV, typename _Up, __vec_builtin _IV, _ArchTraits _Traits = {}>
+    [[__gnu__::__always_inline__]]
+    inline void
+    __x86_scatter(const _TV __v, _Up* __mem, const _IV __idx, unsigned_integral auto __k)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      constexpr int __n = __width_of<_TV>;
+      constexpr int __isize = sizeof(__vec_value_type<_IV>);
+      static_assert(__converts_trivially<_Tp, _Up> && (sizeof(_Tp) == 4 || sizeof(_Tp) == 8));
+      static_assert(__width_of<_IV> == __n && (__isize == 4 || __isize == 8));
+      static_assert(_Traits._M_have_avx512f());
+      constexpr int __elsize = std::max(int(sizeof(_Tp)), __isize);
+      constexpr int __min_n = 16 / __elsize;
+      constexpr int __full_n = 64 / __elsize;
+      if constexpr (__n < __min_n || (!_Traits._M_have_avx512vl() && __n < __full_n))
+	{
+	  constexpr int __n2 = _Traits._M_have_avx512vl() ? __min_n : __full_n;
+	  __x86_scatter(__vec_zero_pad_to<sizeof(_TV) * __n2 / __n>(__v), __mem,
+			__vec_zero_pad_to<sizeof(_IV) * __n2 / __n>(__idx),
+			unsigned(__k) & ((1u << __n) - 1));
+	}
+      else
+	{
+	  using _Fp = __float_from<sizeof(_Tp)>;
+	  using _Ip = conditional_t<__isize == 4, int, long long>;
+	  auto* __base = reinterpret_cast<_Fp*>(__mem);
+	  const auto __vi = [&] [[__gnu__::__always_inline__]] {
+	    if constexpr (sizeof(_IV) < 16) // 2 x int indices for 2 x double
+	      return __vec_zero_pad_to_16(__vec_bit_cast<_Ip>(__idx));
+	    else
+	      return __vec_bit_cast<_Ip>(__idx);
+	  }();
+	  const auto __w = [&] [[__gnu__::__always_inline__]] {
+	    if constexpr (sizeof(_TV) < 16) // 2 x float with 8-byte indices
+	      return __vec_zero_pad_to_16(__vec_bit_cast<_Fp>(__v));
+	    else
+	      return __vec_bit_cast<_Fp>(__v);
+	  }();
+	  constexpr int __s = sizeof(_Tp);
+	  if constexpr (__s == 4 && __isize == 4 && __n == 16)
+	    __builtin_ia32_scattersiv16sf(__base, __k, __vi, __w, __s);
+	  else if constexpr (__s == 4 && __isize == 4 && __n == 8)
+	    __builtin_ia32_scattersiv8sf(__base, __k, __vi, __w, __s);
+	  else if constexpr (__s == 4 && __isize == 4 && __n == 4)
+	    __builtin_ia32_scattersiv4sf(__base, __k, __vi, __w, __s);
+	  else if constexpr (__s == 4 && __n == 8)
+	    __builtin_ia32_scatterdiv16sf(__base, __k, __vi, __w, __s);
+	  else if constexpr (__s == 4 && __n == 4)
+	    __builtin_ia32_scatterdiv8sf(__base, __k, __vi, __w, __s);
+	  else if constexpr (__s == 4 && __n == 2)
+	    __builtin_ia32_scatterdiv4sf(__base, __k, __vi, __w, __s);
+	  else if constexpr (__isize == 4 && __n == 8)
+	    __builtin_ia32_scattersiv8df(__base, __k, __vi, __w, __s);
+	  else if constexpr (__isize == 4 && __n == 4)
+	    __builtin_ia32_scattersiv4df(__base, __k, __vi, __w, __s);
+	  else if constexpr (__isize == 4 && __n == 2)
+	    __builtin_ia32_scattersiv2df(__base, __k, __vi, __w, __s);
+	  else if constexpr (__n == 8)
+	    __builtin_ia32_scatterdiv8df(__base, __k, __vi, __w, __s);
+	  else if constexpr (__n == 4)
+	    __builtin_ia32_scatterdiv4df(__base, __k, __vi, __w, __s);
+	  else if constexpr (__n == 2)
+	    __builtin_ia32_scatterdiv2df(__base, __k, __vi, __w, __s);
+	  else
+	    static_assert(false);
+	}
+    }
+
+  /** @internal
+   * Non-temporal store (movntps, movntpd, movntdq and their VEX / EVEX forms) of @p __v to
+   * @p __mem, bypassing the cache hierarchy. Call __streaming_fence before other threads read the
+   * stored data.
+   *
+   * @pre @p __mem is aligned to sizeof(_TV).
+   * @note 32-byte vectors require AVX, 64-byte vectors require AVX512F.
+   */
+  template <__vec_builtin _TV>
+    [[__gnu__::__always_inline__]]
+    inline void
+    __x86_stream_store(const _TV __v, void* __mem)
+    {
+      using _Tp = __vec_value_type<_TV>;
+      constexpr int __bytes = sizeof(_TV);
+      static_assert(__bytes == 16 || __bytes == 32 || __bytes == 64);
+      if constexpr (is_floating_point_v<_Tp> && sizeof(_Tp) == 4)
+	{
+	  float* __dst = static_cast<float*>(__mem);
+	  if constexpr (__bytes == 16)
+	    __builtin_ia32_movntps(__dst, __v);
+	  else if constexpr (__bytes == 32)
+	    __builtin_ia32_movntps256(__dst, __v);
+	  else
+	    __builtin_ia32_movntps512(__dst, __v);
+	}
+      else if constexpr (is_floating_point_v<_Tp> && sizeof(_Tp) == 8)
+	{
+	  double* __dst = static_cast<double*>(__mem);
+	  if constexpr (__bytes == 16)
+	    __builtin_ia32_movntpd(__dst, __v);
+	  else if constexpr (__bytes == 32)
+	    __builtin_ia32_movntpd256(__dst, __v);
+	  else
+	    __builtin_ia32_movntpd512(__dst, __v);
+	}
+      else
+	{
+	  const auto __x = __vec_bit_cast<long long>(__v);
+	  auto* __dst = static_cast<remove_const_t<decltype(__x)>*>(__mem);
+	  if constexpr (__bytes == 16)
+	    __builtin_ia32_movntdq(__dst, __x);
+	  else if constexpr (__bytes == 32)
+	    __builtin_ia32_movntdq256(__dst, __x);
+	  else
+	    __builtin_ia32_movntdq512(__dst, __x);
+	}
+    }
+
+  /** @internal
+   * Non-temporal load (movntdqa) of a @p _TV from @p __mem. This only differs from a regular load
+   * for write-combining memory; on write-back memory it is a hint at most.
+   *
+   * @pre @p __mem is aligned to sizeof(_TV).
+   * @note 16-byte vectors require SSE4.1, 32-byte vectors AVX2, and 64-byte vectors AVX512F.
+   */
+  template <__vec_builtin _TV>
+    [[__gnu__::__always_inline__]]
+    inline _TV
+    __x86_stream_load(const void* __mem)
+    {
+      constexpr int __bytes = sizeof(_TV);
+      using _LL = __vec_builtin_type_bytes<long long, __bytes>;
+      _LL* __src = static_cast<_LL*>(const_cast<void*>(__mem));
+      if constexpr (__bytes == 16)
+	return reinterpret_cast<_TV>(__builtin_ia32_movntdqa(__src));
+      else if constexpr (__bytes == 32)
+	return reinterpret_cast<_TV>(__builtin_ia32_movntdqa256(__src));
+      else if constexpr (__bytes == 64)
+	return reinterpret_cast<_TV>(__builtin_ia32_movntdqa512(__src));
+      else
+	static_assert(false);
+    }
+
   /** @internal
    * AVX512 masked stores
    *
@@ -340,7 +340,6 @@ namespace simd
       return __builtin_shufflevector(__x, __y, __n / 2 + __rotr(__is)...);
     }
 #endif
-#if VIR_PATCH_PERMUTE_DYNAMIC
 
   // also see overloads in bits/simd_x86.h
   template <__vec_builtin _TV, __vec_builtin _IV, _ArchTraits = {}>
@@ -355,7 +354,6 @@ namespace simd
       return _TV {__v[__perm[__is]]...};
 #endif
     }
-#endif
 
   /** \internal
    * Simple wrapper around __builtin_convertvector to provide static_cast-like syntax.
@@ -0,0 +1,251 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+// Entry points for callers compiled with -DVIR_MATH_DISPATCH. Their math ABI is
+// _ArchTraits::_S_math_abi_dispatch (except for x86-64-v4 callers, which call the v4 kernels
+// directly). Every entry point is an ifunc that resolves to the best kernel the CPU supports when
+// libsimd.so is loaded. Since the symbol itself is redirected, the kernels' calling convention
+// (including the register return of the second result, see __math_return) is unaffected.
+//
+// This TU is compiled once, for the baseline (v1) target.
+
+#define VIR_EXTENSIONS 1
+
+#include "support.h"
+
+#define STR_IMPL(a) #a
+#define STR(a) STR_IMPL(a)
+
+namespace std::simd
+{
+  namespace
+  {
+    using flt32_2 = __vec_builtin_type<float, 2>;
+    using flt32_4 = __vec_builtin_type<float, 4>;
+    using flt32_8 = __vec_builtin_type<float, 8>;
+
+    using flt64_2 = __vec_builtin_type<double, 2>;
+    using flt64_4 = __vec_builtin_type<double, 4>;
+
+    constexpr _ArchTraits dispatch{_ArchTraits::_S_math_abi_dispatch};
+
+    /// The math ABIs libsimd.so is compiled for, in order of increasing requirements.
+    constexpr _ArchTraits levels[] = {
+      _ArchTraits{_ArchTraits::_S_math_abi_v1}, _ArchTraits{_ArchTraits::_S_math_abi_v2},
+      _ArchTraits{_ArchTraits::_S_math_abi_v3a}, _ArchTraits{_ArchTraits::_S_math_abi_v3b},
+      _ArchTraits{_ArchTraits::_S_math_abi_v4}
+    };
+
+    constexpr _OptTraits precise{0};
+    constexpr _OptTraits finite{0b100};
+
+    /** @internal
+     * Returns the index into @c levels for the CPU we're running on.
+     *
+     * Resolvers run before constructors, so this must call __builtin_cpu_init itself.
+     *
+     * The v4 kernels are compiled with -mavx512fp16 (see archv4 in the Makefile). AVX-512 CPUs
+     * without FP16 (e.g. Skylake-SP, Zen 4) therefore get the v3b kernels.
+     */
+    int
+    cpu_level() noexcept
+    {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("x86-64-v4") && __builtin_cpu_supports("avx512fp16"))
+        return 4;
+      else if (__builtin_cpu_supports("x86-64-v3"))
+        return 3;
+      else if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("sse4.2")
+                 && __builtin_cpu_supports("popcnt"))
+        return 2;
+      else if (__builtin_cpu_supports("sse4.1"))
+        return 1;
+      else
+        return 0;
+    }
+
+    /** @internal
+     * Returns the kernel for the highest level (one kernel per entry in @c levels) the CPU
+     * supports. @c nullptr denotes a level that has no instantiation for the given type (i.e. AVX
+     * types on SSE levels).
+     */
+    template <auto... kernels>
+      requires (sizeof...(kernels) == size(levels))
+      common_type_t<decltype(kernels)...>
+      select_kernel() noexcept
+      {
+        const common_type_t<decltype(kernels)...> table[] = {kernels...};
+        for (int i = cpu_level(); i >= 0; --i)
+          if (table[i])
+            return table[i];
+        __builtin_unreachable();
+      }
+  }
+
+  int
+  __math_dispatch_level() noexcept
+  { return cpu_level(); }
+
+  namespace
+  {
+
+    template <typename V0, typename V1>
+      using ret_2x = __math_results_t<V0, V1>;
+
+    // Pointers to the kernels (compiled in hypot2.cpp and hypot3.cpp for each level)
+    template <_ArchTraits A, typename TV>
+      constexpr TV (*fast_hypot2)(TV, TV) noexcept = &__fast_hypot<A, TV>;
+
+    template <_ArchTraits A, typename TV>
+      constexpr TV (*fast_hypot3)(TV, TV, TV) noexcept = &__fast_hypot<A, TV>;
+
+    template <_ArchTraits A, _OptTraits O, typename TV>
+      constexpr TV (*hypot2)(TV, TV) noexcept = &__hypot<_TargetTraits{A, O}, TV>;
+
+    template <_ArchTraits A, _OptTraits O, typename TV>
+      constexpr TV (*hypot3)(TV, TV, TV) noexcept = &__hypot<_TargetTraits{A, O}, TV>;
+
+    template <_ArchTraits A, typename V0, typename V1>
+      constexpr ret_2x<V0, V1> (*fast_2x_hypot2)(V0, V0, V1, V1) noexcept
+        = &__fast_2x_hypot<A, V0, V1>;
+
+    template <_ArchTraits A, typename V0, typename V1>
+      constexpr ret_2x<V0, V1> (*fast_2x_hypot3)(V0, V0, V0, V1, V1, V1) noexcept
+        = &__fast_2x_hypot<A, V0, V1>;
+
+    template <_ArchTraits A, _OptTraits O, typename V0, typename V1>
+      constexpr ret_2x<V0, V1> (*x2_hypot2)(V0, V0, V1, V1) noexcept
+        = &__2x_hypot<_TargetTraits{A, O}, V0, V1>;
+
+    template <_ArchTraits A, _OptTraits O, typename V0, typename V1>
+      constexpr ret_2x<V0, V1> (*x2_hypot3)(V0, V0, V0, V1, V1, V1) noexcept
+        = &__2x_hypot<_TargetTraits{A, O}, V0, V1>;
+
+    template <typename TV>
+      using ret_int = __math_results_t<TV, __vec_builtin_type<int, __width_of<TV>>>;
+
+    // Pointers to the kernels in sincos.cpp, frexp.cpp, and remquo.cpp
+    template <_ArchTraits A, _OptTraits O, typename TV>
+      constexpr ret_2x<TV, TV> (*sincos_k)(TV) noexcept = &__sincos<_TargetTraits{A, O}, TV>;
+
+    template <_ArchTraits A, _OptTraits O, typename TV>
+      constexpr ret_int<TV> (*frexp_k)(TV) noexcept = &__frexp<_TargetTraits{A, O}, TV>;
+
+    template <_ArchTraits A, _OptTraits O, typename TV>
+      constexpr ret_int<TV> (*remquo_k)(TV, TV) noexcept = &__remquo<_TargetTraits{A, O}, TV>;
+  }
+
+// kernels for all levels / only for levels with AVX
+#define ALL_LEVELS(K, ...)                                                                         \
+  K<levels[0], __VA_ARGS__>, K<levels[1], __VA_ARGS__>, K<levels[2], __VA_ARGS__>,                 \
+  K<levels[3], __VA_ARGS__>, K<levels[4], __VA_ARGS__>
+#define AVX_LEVELS(K, ...)                                                                         \
+  nullptr, nullptr, K<levels[2], __VA_ARGS__>, K<levels[3], __VA_ARGS__>, K<levels[4], __VA_ARGS__>
+
+#define RESOLVER(name, ...)                                                                        \
+  extern "C" {                                                                                     \
+    [[gnu::used]] static auto                                                                      \
+    name() noexcept                                                                                \
+    { return select_kernel<__VA_ARGS__>(); }                                                       \
+  }
+
+// 1x entry points: TV fn(TV, TV[, TV])
+#define DISPATCH_1X(LEVELS, TV)                                                                    \
+  RESOLVER(resolve_fast_hypot2_##TV, LEVELS(fast_hypot2, TV))                                      \
+  RESOLVER(resolve_hypot2_##TV, LEVELS(hypot2, precise, TV))                                       \
+  RESOLVER(resolve_finite_hypot2_##TV, LEVELS(hypot2, finite, TV))                                 \
+  RESOLVER(resolve_fast_hypot3_##TV, LEVELS(fast_hypot3, TV))                                      \
+  RESOLVER(resolve_hypot3_##TV, LEVELS(hypot3, precise, TV))                                       \
+  RESOLVER(resolve_finite_hypot3_##TV, LEVELS(hypot3, finite, TV))                                 \
+                                                                                                   \
+  template <> [[gnu::ifunc(STR(resolve_fast_hypot2_##TV))]]                                        \
+  TV __fast_hypot<dispatch, TV>(TV, TV) noexcept;                                                  \
+  template <> [[gnu::ifunc(STR(resolve_hypot2_##TV))]]                                             \
+  TV __hypot<_TargetTraits{dispatch, precise}, TV>(TV, TV) noexcept;                               \
+  template <> [[gnu::ifunc(STR(resolve_finite_hypot2_##TV))]]                                      \
+  TV __hypot<_TargetTraits{dispatch, finite}, TV>(TV, TV) noexcept;                                \
+  template <> [[gnu::ifunc(STR(resolve_fast_hypot3_##TV))]]                                        \
+  TV __fast_hypot<dispatch, TV>(TV, TV, TV) noexcept;                                              \
+  template <> [[gnu::ifunc(STR(resolve_hypot3_##TV))]]                                             \
+  TV __hypot<_TargetTraits{dispatch, precise}, TV>(TV, TV, TV) noexcept;                           \
+  template <> [[gnu::ifunc(STR(resolve_finite_hypot3_##TV))]]                                      \
+  TV __hypot<_TargetTraits{dispatch, finite}, TV>(TV, TV, TV) noexcept;
+
+// entry points with a second result: sincos, frexp, remquo
+#define DISPATCH_RESULTS(LEVELS, TV)                                                               \
+  RESOLVER(resolve_sincos_##TV, LEVELS(sincos_k, precise, TV))                                     \
+  RESOLVER(resolve_finite_sincos_##TV, LEVELS(sincos_k, finite, TV))                               \
+  RESOLVER(resolve_frexp_##TV, LEVELS(frexp_k, precise, TV))                                       \
+  RESOLVER(resolve_finite_frexp_##TV, LEVELS(frexp_k, finite, TV))                                 \
+  RESOLVER(resolve_remquo_##TV, LEVELS(remquo_k, precise, TV))                                     \
+  RESOLVER(resolve_finite_remquo_##TV, LEVELS(remquo_k, finite, TV))                               \
+                                                                                                   \
+  template <> [[gnu::ifunc(STR(resolve_sincos_##TV))]]                                             \
+  ret_2x<TV, TV> __sincos<_TargetTraits{dispatch, precise}, TV>(TV) noexcept;                      \
+  template <> [[gnu::ifunc(STR(resolve_finite_sincos_##TV))]]                                      \
+  ret_2x<TV, TV> __sincos<_TargetTraits{dispatch, finite}, TV>(TV) noexcept;                       \
+  template <> [[gnu::ifunc(STR(resolve_frexp_##TV))]]                                              \
+  ret_int<TV> __frexp<_TargetTraits{dispatch, precise}, TV>(TV) noexcept;                          \
+  template <> [[gnu::ifunc(STR(resolve_finite_frexp_##TV))]]                                       \
+  ret_int<TV> __frexp<_TargetTraits{dispatch, finite}, TV>(TV) noexcept;                           \
+  template <> [[gnu::ifunc(STR(resolve_remquo_##TV))]]                                             \
+  ret_int<TV> __remquo<_TargetTraits{dispatch, precise}, TV>(TV, TV) noexcept;                     \
+  template <> [[gnu::ifunc(STR(resolve_finite_remquo_##TV))]]                                      \
+  ret_int<TV> __remquo<_TargetTraits{dispatch, finite}, TV>(TV, TV) noexcept;
+
+// 2x entry points: ret_2x<V0, V1> fn(V0, V0[, V0], V1, V1[, V1])
+#define DISPATCH_2X(LEVELS, V0, V1)                                                                \
+  RESOLVER(resolve_fast_2x_hypot2_##V0##_##V1, LEVELS(fast_2x_hypot2, V0, V1))                     \
+  RESOLVER(resolve_2x_hypot2_##V0##_##V1, LEVELS(x2_hypot2, precise, V0, V1))                      \
+  RESOLVER(resolve_finite_2x_hypot2_##V0##_##V1, LEVELS(x2_hypot2, finite, V0, V1))                \
+  RESOLVER(resolve_fast_2x_hypot3_##V0##_##V1, LEVELS(fast_2x_hypot3, V0, V1))                     \
+  RESOLVER(resolve_2x_hypot3_##V0##_##V1, LEVELS(x2_hypot3, precise, V0, V1))                      \
+  RESOLVER(resolve_finite_2x_hypot3_##V0##_##V1, LEVELS(x2_hypot3, finite, V0, V1))                \
+                                                                                                   \
+  template <> [[gnu::ifunc(STR(resolve_fast_2x_hypot2_##V0##_##V1))]]                              \
+  ret_2x<V0, V1> __fast_2x_hypot<dispatch, V0, V1>(V0, V0, V1, V1) noexcept;                       \
+  template <> [[gnu::ifunc(STR(resolve_2x_hypot2_##V0##_##V1))]]                                   \
+  ret_2x<V0, V1> __2x_hypot<_TargetTraits{dispatch, precise}, V0, V1>(V0, V0, V1, V1) noexcept;    \
+  template <> [[gnu::ifunc(STR(resolve_finite_2x_hypot2_##V0##_##V1))]]                            \
+  ret_2x<V0, V1> __2x_hypot<_TargetTraits{dispatch, finite}, V0, V1>(V0, V0, V1, V1) noexcept;     \
+  template <> [[gnu::ifunc(STR(resolve_fast_2x_hypot3_##V0##_##V1))]]                              \
+  ret_2x<V0, V1> __fast_2x_hypot<dispatch, V0, V1>(V0, V0, V0, V1, V1, V1) noexcept;               \
+  template <> [[gnu::ifunc(STR(resolve_2x_hypot3_##V0##_##V1))]]                                   \
+  ret_2x<V0, V1>                                                                                   \
+  __2x_hypot<_TargetTraits{dispatch, precise}, V0, V1>(V0, V0, V0, V1, V1, V1) noexcept;           \
+  template <> [[gnu::ifunc(STR(resolve_finite_2x_hypot3_##V0##_##V1))]]                            \
+  ret_2x<V0, V1>                                                                                   \
+  __2x_hypot<_TargetTraits{dispatch, finite}, V0, V1>(V0, V0, V0, V1, V1, V1) noexcept;
+
+  DISPATCH_1X(ALL_LEVELS, flt32_2)
+  DISPATCH_1X(ALL_LEVELS, flt32_4)
+  DISPATCH_1X(ALL_LEVELS, flt64_2)
+  DISPATCH_1X(AVX_LEVELS, flt32_8)
+  DISPATCH_1X(AVX_LEVELS, flt64_4)
+
+  DISPATCH_RESULTS(ALL_LEVELS, flt32_2)
+  DISPATCH_RESULTS(ALL_LEVELS, flt32_4)
+  DISPATCH_RESULTS(ALL_LEVELS, flt64_2)
+  DISPATCH_RESULTS(AVX_LEVELS, flt32_8)
+  DISPATCH_RESULTS(AVX_LEVELS, flt64_4)
+
+  // A caller without AVX splits vec<float, 6> into (4, 2) and calls the 2x entry point. On AVX
+  // hardware both halves are then processed in a single ymm register (see can_batch_2x).
+  DISPATCH_2X(ALL_LEVELS, flt32_4, flt32_2)
+  DISPATCH_2X(ALL_LEVELS, flt32_4, flt32_4)
+  DISPATCH_2X(ALL_LEVELS, flt64_2, flt64_2)
+  DISPATCH_2X(AVX_LEVELS, flt32_8, flt32_2)
+  DISPATCH_2X(AVX_LEVELS, flt32_8, flt32_4)
+  DISPATCH_2X(AVX_LEVELS, flt32_8, flt32_8)
+  DISPATCH_2X(AVX_LEVELS, flt64_4, flt64_2)
+  DISPATCH_2X(AVX_LEVELS, flt64_4, flt64_4)
+
+#undef DISPATCH_2X
+#undef DISPATCH_RESULTS
+#undef DISPATCH_1X
+#undef RESOLVER
+#undef AVX_LEVELS
+#undef ALL_LEVELS
+}
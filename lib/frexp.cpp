@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#define VIR_EXTENSIONS 1
+
+#include "support.h"
+
+namespace std::simd
+{
+  template <_TargetTraits Traits = _TargetTraits()._M_math_abi(), typename TV>
+    [[gnu::flatten]]
+    __math_results_t<TV, __vec_builtin_type<int, __width_of<TV>>>
+    __frexp(TV x) noexcept
+    {
+      using V = vec<__vec_value_type<TV>, __width_of<TV>>;
+      rebind_t<int, V> e;
+      TV m = __frexp_kernel<Traits>(V(x), e);
+      __vec_builtin_type<int, __width_of<TV>> ev = e;
+      return __math_return(m, ev);
+    }
+
+#define INSTANTIATE(TV)                                                                            \
+  template __math_results_t<TV, __vec_builtin_type<int, __width_of<TV>>> __frexp(TV) noexcept;
+#include "instantiate_results.h"
+}
@@ -41,26 +41,26 @@ template flt16_8 CONCAT(__, FN)(flt16_8, flt16_8, flt16_8);
 template flt16_16 CONCAT(__, FN)(flt16_16, flt16_16, flt16_16);
 template flt16_32 CONCAT(__, FN)(flt16_32, flt16_32, flt16_32);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_2)
+template __math_results_t<flt16_32, flt16_2>
 CONCAT(__fast_2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_2, flt16_2, flt16_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_4)
+template __math_results_t<flt16_32, flt16_4>
 CONCAT(__fast_2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_4, flt16_4, flt16_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_8)
+template __math_results_t<flt16_32, flt16_8>
 CONCAT(__fast_2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_8, flt16_8, flt16_8);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_16)
+template __math_results_t<flt16_32, flt16_16>
 CONCAT(__fast_2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_16, flt16_16, flt16_16);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_32)
+template __math_results_t<flt16_32, flt16_32>
 CONCAT(__fast_2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_32, flt16_32, flt16_32);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_2)
+template __math_results_t<flt16_32, flt16_2>
 CONCAT(__2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_2, flt16_2, flt16_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_4)
+template __math_results_t<flt16_32, flt16_4>
 CONCAT(__2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_4, flt16_4, flt16_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_8)
+template __math_results_t<flt16_32, flt16_8>
 CONCAT(__2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_8, flt16_8, flt16_8);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_16)
+template __math_results_t<flt16_32, flt16_16>
 CONCAT(__2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_16, flt16_16, flt16_16);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt16_32, flt16_32)
+template __math_results_t<flt16_32, flt16_32>
 CONCAT(__2x_, FN)(flt16_32, flt16_32, flt16_32, flt16_32, flt16_32, flt16_32);
 #endif
 
@@ -89,69 +89,79 @@ template flt64_8  CONCAT(__, FN)(flt64_8, flt64_8, flt64_8);
 #endif
 
 #ifdef __AVX512F__
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_2)
+template __math_results_t<flt32_16, flt32_2>
 CONCAT(__fast_2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_2, flt32_2, flt32_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_4)
+template __math_results_t<flt32_16, flt32_4>
 CONCAT(__fast_2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_4, flt32_4, flt32_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_8)
+template __math_results_t<flt32_16, flt32_8>
 CONCAT(__fast_2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_8, flt32_8, flt32_8);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_16)
+template __math_results_t<flt32_16, flt32_16>
 CONCAT(__fast_2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_16, flt32_16, flt32_16);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_8, flt64_2)
+template __math_results_t<flt64_8, flt64_2>
 CONCAT(__fast_2x_, FN)(flt64_8, flt64_8, flt64_8, flt64_2, flt64_2, flt64_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_8, flt64_4)
+template __math_results_t<flt64_8, flt64_4>
 CONCAT(__fast_2x_, FN)(flt64_8, flt64_8, flt64_8, flt64_4, flt64_4, flt64_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_8, flt64_8)
+template __math_results_t<flt64_8, flt64_8>
 CONCAT(__fast_2x_, FN)(flt64_8, flt64_8, flt64_8, flt64_8, flt64_8, flt64_8);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_2)
+template __math_results_t<flt32_16, flt32_2>
 CONCAT(__2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_2, flt32_2, flt32_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_4)
+template __math_results_t<flt32_16, flt32_4>
 CONCAT(__2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_4, flt32_4, flt32_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_8)
+template __math_results_t<flt32_16, flt32_8>
 CONCAT(__2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_8, flt32_8, flt32_8);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_16, flt32_16)
+template __math_results_t<flt32_16, flt32_16>
 CONCAT(__2x_, FN)(flt32_16, flt32_16, flt32_16, flt32_16, flt32_16, flt32_16);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_8, flt64_2)
+template __math_results_t<flt64_8, flt64_2>
 CONCAT(__2x_, FN)(flt64_8, flt64_8, flt64_8, flt64_2, flt64_2, flt64_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_8, flt64_4)
+template __math_results_t<flt64_8, flt64_4>
 CONCAT(__2x_, FN)(flt64_8, flt64_8, flt64_8, flt64_4, flt64_4, flt64_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_8, flt64_8)
+template __math_results_t<flt64_8, flt64_8>
 CONCAT(__2x_, FN)(flt64_8, flt64_8, flt64_8, flt64_8, flt64_8, flt64_8);
-#elif defined __AVX__
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_8, flt32_2)
+#endif
+
+#ifdef __AVX__
+template __math_results_t<flt32_8, flt32_2>
 CONCAT(__fast_2x_, FN)(flt32_8, flt32_8, flt32_8, flt32_2, flt32_2, flt32_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_8, flt32_4)
+template __math_results_t<flt32_8, flt32_4>
 CONCAT(__fast_2x_, FN)(flt32_8, flt32_8, flt32_8, flt32_4, flt32_4, flt32_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_8, flt32_8)
+template __math_results_t<flt32_8, flt32_8>
 CONCAT(__fast_2x_, FN)(flt32_8, flt32_8, flt32_8, flt32_8, flt32_8, flt32_8);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_4, flt64_2)
+template __math_results_t<flt64_4, flt64_2>
 CONCAT(__fast_2x_, FN)(flt64_4, flt64_4, flt64_4, flt64_2, flt64_2, flt64_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_4, flt64_4)
+template __math_results_t<flt64_4, flt64_4>
 CONCAT(__fast_2x_, FN)(flt64_4, flt64_4, flt64_4, flt64_4, flt64_4, flt64_4);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_8, flt32_2)
+template __math_results_t<flt32_8, flt32_2>
 CONCAT(__2x_, FN)(flt32_8, flt32_8, flt32_8, flt32_2, flt32_2, flt32_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_8, flt32_4)
+template __math_results_t<flt32_8, flt32_4>
 CONCAT(__2x_, FN)(flt32_8, flt32_8, flt32_8, flt32_4, flt32_4, flt32_4);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_8, flt32_8)
+template __math_results_t<flt32_8, flt32_8>
 CONCAT(__2x_, FN)(flt32_8, flt32_8, flt32_8, flt32_8, flt32_8, flt32_8);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_4, flt64_2)
+template __math_results_t<flt64_4, flt64_2>
 CONCAT(__2x_, FN)(flt64_4, flt64_4, flt64_4, flt64_2, flt64_2, flt64_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt64_4, flt64_4)
+template __math_results_t<flt64_4, flt64_4>
 CONCAT(__2x_, FN)(flt64_4, flt64_4, flt64_4, flt64_4, flt64_4, flt64_4);
-#else
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_4, flt32_2)
+#endif
+
+// The narrower 2x shapes are instantiated for every target, so that the dispatching entry
+// points (dispatch.cpp) can call them on better hardware (and batch both halves into one register).
+template __math_results_t<flt32_4, flt32_2>
 CONCAT(__fast_2x_, FN)(flt32_4, flt32_4, flt32_4, flt32_2, flt32_2, flt32_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_4, flt32_4)
+template __math_results_t<flt32_4, flt32_4>
 CONCAT(__fast_2x_, FN)(flt32_4, flt32_4, flt32_4, flt32_4, flt32_4, flt32_4);
 
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_4, flt32_2)
+template __math_results_t<flt32_4, flt32_2>
 CONCAT(__2x_, FN)(flt32_4, flt32_4, flt32_4, flt32_2, flt32_2, flt32_2);
-template _GLIBCXX_SIMD_MATH_RET_TYPE(flt32_4, flt32_4)
+template __math_results_t<flt32_4, flt32_4>
 CONCAT(__2x_, FN)(flt32_4, flt32_4, flt32_4, flt32_4, flt32_4, flt32_4);
-#endif
+
+template __math_results_t<flt64_2, flt64_2>
+CONCAT(__fast_2x_, FN)(flt64_2, flt64_2, flt64_2, flt64_2, flt64_2, flt64_2);
+
+template __math_results_t<flt64_2, flt64_2>
+CONCAT(__2x_, FN)(flt64_2, flt64_2, flt64_2, flt64_2, flt64_2, flt64_2);
@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+// Instantiates the entry points with two results (sincos, frexp, remquo). These have no fast or
+// 2x variants. INSTANTIATE(TV) must declare the explicit instantiation for the float vector TV.
+
+#ifndef INSTANTIATE
+#error "must define INSTANTIATE"
+#endif
+
+namespace
+{
+using flt32_2 = __vec_builtin_type<float, 2>;
+using flt32_4 = __vec_builtin_type<float, 4>;
+using flt32_8 = __vec_builtin_type<float, 8>;
+using flt32_16 = __vec_builtin_type<float, 16>;
+
+using flt64_2 = __vec_builtin_type<double, 2>;
+using flt64_4 = __vec_builtin_type<double, 4>;
+using flt64_8 = __vec_builtin_type<double, 8>;
+}
+
+INSTANTIATE(flt32_2)
+INSTANTIATE(flt32_4)
+INSTANTIATE(flt64_2)
+#ifdef __AVX__
+INSTANTIATE(flt32_8)
+INSTANTIATE(flt64_4)
+#endif
+#ifdef __AVX512F__
+INSTANTIATE(flt32_16)
+INSTANTIATE(flt64_8)
+#endif
+
+#undef INSTANTIATE
@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: GPL-3.0-or-later WITH GCC-exception-3.1 */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#define VIR_EXTENSIONS 1
+
+#include "support.h"
+
+namespace std::simd
+{
+  template <_TargetTraits Traits = _TargetTraits()._M_math_abi(), typename TV>
+    [[gnu::flatten]]
+    __math_results_t<TV, TV>
+    __sincos(TV x) noexcept
+    {
+      using V = vec<__vec_value_type<TV>, __width_of<TV>>;
+      V c;
+      TV s = __sincos_kernel<Traits>(V(x), c);
+      TV cv = c;
+      return __math_return(s, cv);
+    }
+
+#define INSTANTIATE(TV) template __math_results_t<TV, TV> __sincos(TV) noexcept;
+#include "instantiate_results.h"
+}
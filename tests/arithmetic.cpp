@@ -135,6 +135,31 @@ template <typename V>
 	t.verify_bit_equal(0. + -0., 0.);
       }
     };
+
+    ADD_TEST(fma) {
+      std::tuple {V(RealV(Real(1)), RealV()), V(RealV(), RealV(Real(1))),
+		  init_vec<V, C(0, 2), C(2, 0), C(-1, 2)>},
+      [](auto& t, V one, V I, V z) {
+	t.verify_equal(fma(one, one, one), T(2, 0));
+	t.verify_equal(fma(I, I, one), T());
+	t.verify_equal(fma(z, I, z), z * I + z);
+	t.verify_equal(fma(z, z, -(z * z)), T());
+	t.verify_equal(fma(z, one, I), z + I);
+      }
+    };
+
+    // all lanes differ and the products of the small integers are exact, even for _Float16: the
+    // vfmulcph / vfmaddcph path must match complex<T> element by element
+    ADD_TEST(mul_fma_lanes) {
+      std::tuple {V([](int i) { return T(Real(i % 5 - 2), Real(i % 3 - 1)); }),
+		  V([](int i) { return T(Real(i % 4 - 1), Real(2 - i % 7)); })},
+      [](auto& t, V x, V y) {
+	t.verify_equal(x * y, V([&](int i) { return x[i] * y[i]; }));
+	t.verify_equal(x * conj(y), V([&](int i) { return x[i] * std::conj(y[i]); }));
+	t.verify_equal(fma(x, y, x), V([&](int i) { return x[i] * y[i] + x[i]; }));
+	t.verify_equal(fma(y, x, -y), V([&](int i) { return y[i] * x[i] - y[i]; }));
+      }
+    };
   };
 
 template <typename V>
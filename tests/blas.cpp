@@ -0,0 +1,300 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+#include "unittest.h"
+
+#include <complex>
+#include <span>
+
+// no tests for integral types
+template <typename V>
+  struct Tests {};
+
+template <typename T>
+  struct real_type
+  { using type = T; };
+
+template <typename T>
+  struct real_type<std::complex<T>>
+  { using type = T; };
+
+template <typename V>
+  requires std::floating_point<typename V::value_type> || complex_like<typename V::value_type>
+  struct Tests<V>
+  {
+    using T = typename V::value_type;
+    using R = typename real_type<T>::type;
+    using C = std::complex<R>;
+
+    // small integers: all products and sums are exact, even for _Float16
+    static constexpr C
+    x_at(int i)
+    { return C(R(i % 7 - 3), R(i % 5 - 2)); }
+
+    static constexpr C
+    y_at(int i)
+    { return C(R(i % 3 - 1), R(i % 4 - 2)); }
+
+    /**
+     * Sizes that cover the empty range, the tail only, the remainder loop, and the unrolled loop
+     * of the kernels for vecs of @p w elements.
+     */
+    static constexpr std::array<int, 7>
+    sizes_for(int w)
+    { return {0, 1, w + 1, 2 * w - 1, 4 * w, 5 * w + 1, 9 * w + 3}; }
+
+    // the kernels don't depend on V, only on its value_type: test once per type
+    static constexpr bool native_width = V::size() == simd::vec<T>::size();
+
+    ADD_TEST(interleaved, complex_like<T> && native_width) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	constexpr int w = simd::vec<C>::size();
+	constexpr int max_n = 9 * w + 3;
+	const C alpha(R(2), R(-1));
+	for (int n : sizes_for(w))
+	  {
+	    std::array<C, max_n> x = {};
+	    std::array<C, max_n> y = {};
+	    for (int i = 0; i < n; ++i)
+	      {
+		x[i] = x_at(i);
+		y[i] = y_at(i);
+	      }
+	    const std::span<C> xs(x.data(), n);
+	    const std::span<C> ys(y.data(), n);
+
+	    C ref_dot = {};
+	    C ref_dotc = {};
+	    for (int i = 0; i < n; ++i)
+	      {
+		ref_dot += x[i] * y[i];
+		ref_dotc += std::conj(x[i]) * y[i];
+	      }
+	    const C d = simd::dot(xs, ys);
+	    const C dc = simd::dotc(xs, ys);
+	    t.verify_equal(d.real(), ref_dot.real())("n =", n);
+	    t.verify_equal(d.imag(), ref_dot.imag())("n =", n);
+	    t.verify_equal(dc.real(), ref_dotc.real())("n =", n);
+	    t.verify_equal(dc.imag(), ref_dotc.imag())("n =", n);
+
+	    std::array<C, max_n> z = y;
+	    simd::axpy(alpha, xs, std::span<C>(z.data(), n));
+	    for (int i = 0; i < max_n; ++i)
+	      {
+		const C ref = i < n ? alpha * x[i] + y[i] : C();
+		t.verify_equal(z[i].real(), ref.real())("n =", n, "i =", i);
+		t.verify_equal(z[i].imag(), ref.imag())("n =", n, "i =", i);
+	      }
+
+	    // x and y alias: x[i] = alpha * x[i] + x[i]
+	    std::array<C, max_n> a = x;
+	    simd::axpy(alpha, std::span<C>(a.data(), n), std::span<C>(a.data(), n));
+	    for (int i = 0; i < n; ++i)
+	      {
+		const C ref = alpha * x[i] + x[i];
+		t.verify_equal(a[i].real(), ref.real())("n =", n, "i =", i);
+		t.verify_equal(a[i].imag(), ref.imag())("n =", n, "i =", i);
+	      }
+
+	    z = x;
+	    simd::scal(alpha, std::span<C>(z.data(), n));
+	    for (int i = 0; i < max_n; ++i)
+	      {
+		const C ref = i < n ? alpha * x[i] : C();
+		t.verify_equal(z[i].real(), ref.real())("n =", n, "i =", i);
+		t.verify_equal(z[i].imag(), ref.imag())("n =", n, "i =", i);
+	      }
+
+	    // also during constant evaluation, where nrm2 cannot reinterpret complex<R> as R[2]
+	    double sum = 0;
+	    for (int i = 0; i < n; ++i)
+	      sum += double(std::norm(x[i]));
+	    const R ref = R(std::sqrt(sum));
+	    const R r = simd::nrm2(xs);
+	    t.verify(r <= ref * R(1.01) && r >= ref * R(0.99))("n =", n, r, ref);
+	  }
+	if !consteval
+	  {
+	    // the squares overflow, the norm does not
+	    constexpr R big = std::numeric_limits<R>::max() / 4;
+	    const std::array<C, 2> huge = {C(big, R()), C(R(), big)};
+	    const R r = simd::nrm2(huge);
+	    const R ref = big * R(1.4142135623730951);
+	    t.verify(r <= ref * R(1.01) && r >= ref * R(0.99))(r, ref);
+	  }
+      }
+    };
+
+    ADD_TEST(split, std::floating_point<T> && native_width) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	constexpr int w = simd::vec<R>::size();
+	constexpr int max_n = 9 * w + 3;
+	const C alpha(R(2), R(-1));
+	for (int n : sizes_for(w))
+	  {
+	    std::array<R, max_n> xr = {}, xi = {}, yr = {}, yi = {};
+	    for (int i = 0; i < n; ++i)
+	      {
+		xr[i] = x_at(i).real();
+		xi[i] = x_at(i).imag();
+		yr[i] = y_at(i).real();
+		yi[i] = y_at(i).imag();
+	      }
+	    const auto s = [n](std::array<R, max_n>& a) { return std::span<R>(a.data(), n); };
+
+	    C ref_dot = {};
+	    C ref_dotc = {};
+	    for (int i = 0; i < n; ++i)
+	      {
+		ref_dot += x_at(i) * y_at(i);
+		ref_dotc += std::conj(x_at(i)) * y_at(i);
+	      }
+	    const C d = simd::dot(s(xr), s(xi), s(yr), s(yi));
+	    const C dc = simd::dotc(s(xr), s(xi), s(yr), s(yi));
+	    t.verify_equal(d.real(), ref_dot.real())("n =", n);
+	    t.verify_equal(d.imag(), ref_dot.imag())("n =", n);
+	    t.verify_equal(dc.real(), ref_dotc.real())("n =", n);
+	    t.verify_equal(dc.imag(), ref_dotc.imag())("n =", n);
+
+	    std::array<R, max_n> zr = yr, zi = yi;
+	    simd::axpy(alpha, s(xr), s(xi), s(zr), s(zi));
+	    for (int i = 0; i < max_n; ++i)
+	      {
+		const C ref = i < n ? alpha * x_at(i) + y_at(i) : C();
+		t.verify_equal(zr[i], ref.real())("n =", n, "i =", i);
+		t.verify_equal(zi[i], ref.imag())("n =", n, "i =", i);
+	      }
+
+	    // x and y alias
+	    zr = xr;
+	    zi = xi;
+	    simd::axpy(alpha, s(zr), s(zi), s(zr), s(zi));
+	    for (int i = 0; i < n; ++i)
+	      {
+		const C ref = alpha * x_at(i) + x_at(i);
+		t.verify_equal(zr[i], ref.real())("n =", n, "i =", i);
+		t.verify_equal(zi[i], ref.imag())("n =", n, "i =", i);
+	      }
+
+	    zr = xr;
+	    zi = xi;
+	    simd::scal(alpha, s(zr), s(zi));
+	    for (int i = 0; i < max_n; ++i)
+	      {
+		const C ref = i < n ? alpha * x_at(i) : C();
+		t.verify_equal(zr[i], ref.real())("n =", n, "i =", i);
+		t.verify_equal(zi[i], ref.imag())("n =", n, "i =", i);
+	      }
+
+	    if !consteval
+	      {
+		double sum = 0;
+		for (int i = 0; i < n; ++i)
+		  sum += double(std::norm(x_at(i)));
+		const R ref = R(std::sqrt(sum));
+		const R r = simd::nrm2(s(xr), s(xi));
+		t.verify(r <= ref * R(1.01) && r >= ref * R(0.99))("n =", n, r, ref);
+	      }
+	  }
+#ifndef __FAST_MATH__ // denormals are flushed to zero
+	if !consteval
+	  {
+	    constexpr R tiny = std::numeric_limits<R>::denorm_min() * R(4);
+	    std::array<R, 2> re = {tiny, tiny};
+	    std::array<R, 2> im = {tiny, tiny};
+	    const R r = simd::nrm2(re, im);
+	    t.verify(r == tiny * R(2))(r);
+	  }
+#endif
+      }
+    };
+
+    // the tails of padded_vector arguments are loaded and stored as complete vecs
+    ADD_TEST(padded, native_width) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	constexpr int w = V::size();
+	const C alpha(R(2), R(-1));
+	for (int n : {1, w + 1, 5 * w + 1})
+	  {
+	    C ref_dot = {};
+	    C ref_dotc = {};
+	    for (int i = 0; i < n; ++i)
+	      {
+		ref_dot += x_at(i) * y_at(i);
+		ref_dotc += std::conj(x_at(i)) * y_at(i);
+	      }
+	    if constexpr (complex_like<T>)
+	      {
+		simd::padded_vector<C> x(n), y(n);
+		for (int i = 0; i < n; ++i)
+		  {
+		    x[i] = x_at(i);
+		    y[i] = y_at(i);
+		  }
+		const C d = simd::dot(x, y);
+		const C dc = simd::dotc(x, y);
+		t.verify_equal(d.real(), ref_dot.real())("n =", n);
+		t.verify_equal(d.imag(), ref_dot.imag())("n =", n);
+		t.verify_equal(dc.real(), ref_dotc.real())("n =", n);
+		t.verify_equal(dc.imag(), ref_dotc.imag())("n =", n);
+
+		simd::axpy(alpha, x, y);
+		t.verify_equal(y.size(), size_t(n));
+		for (int i = 0; i < n; ++i)
+		  {
+		    const C ref = alpha * x_at(i) + y_at(i);
+		    t.verify_equal(y[i].real(), ref.real())("n =", n, "i =", i);
+		    t.verify_equal(y[i].imag(), ref.imag())("n =", n, "i =", i);
+		  }
+
+		simd::scal(alpha, x);
+		for (int i = 0; i < n; ++i)
+		  {
+		    const C ref = alpha * x_at(i);
+		    t.verify_equal(x[i].real(), ref.real())("n =", n, "i =", i);
+		    t.verify_equal(x[i].imag(), ref.imag())("n =", n, "i =", i);
+		  }
+	      }
+	    else
+	      {
+		simd::padded_vector<R> xr(n), xi(n), yr(n), yi(n);
+		for (int i = 0; i < n; ++i)
+		  {
+		    xr[i] = x_at(i).real();
+		    xi[i] = x_at(i).imag();
+		    yr[i] = y_at(i).real();
+		    yi[i] = y_at(i).imag();
+		  }
+		const C d = simd::dot(xr, xi, yr, yi);
+		const C dc = simd::dotc(xr, xi, yr, yi);
+		t.verify_equal(d.real(), ref_dot.real())("n =", n);
+		t.verify_equal(d.imag(), ref_dot.imag())("n =", n);
+		t.verify_equal(dc.real(), ref_dotc.real())("n =", n);
+		t.verify_equal(dc.imag(), ref_dotc.imag())("n =", n);
+
+		simd::axpy(alpha, xr, xi, yr, yi);
+		t.verify_equal(yr.size(), size_t(n));
+		for (int i = 0; i < n; ++i)
+		  {
+		    const C ref = alpha * x_at(i) + y_at(i);
+		    t.verify_equal(yr[i], ref.real())("n =", n, "i =", i);
+		    t.verify_equal(yi[i], ref.imag())("n =", n, "i =", i);
+		  }
+
+		simd::scal(alpha, xr, xi);
+		for (int i = 0; i < n; ++i)
+		  {
+		    const C ref = alpha * x_at(i);
+		    t.verify_equal(xr[i], ref.real())("n =", n, "i =", i);
+		    t.verify_equal(xi[i], ref.imag())("n =", n, "i =", i);
+		  }
+	      }
+	  }
+      }
+    };
+  };
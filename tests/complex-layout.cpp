@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+// requires complex
+
+#include "unittest.h"
+
+// no tests for non-complex types
+template <typename V>
+  struct Tests {};
+
+template <typename V>
+  requires complex_like<typename V::value_type>
+  struct Tests<V>
+  {
+    using T = typename V::value_type;
+    using M = typename V::mask_type;
+    using Real = typename T::value_type;
+    using RV = simd::rebind_t<Real, V>;
+
+    // small integers: products and sums are exact
+    static constexpr RV re_init = RV([](int i) { return Real(i % 7 - 3); });
+    static constexpr RV im_init = RV([](int i) { return Real(i % 5 - 2); });
+
+    ADD_TEST(from_real_imag) {
+      std::tuple {re_init, im_init},
+      [](auto& t, RV re, RV im) {
+	const V x(re, im);
+	t.verify_equal(x.real(), re);
+	t.verify_equal(x.imag(), im);
+	t.verify_equal(x, V([&](int i) { return T(re[i], im[i]); }));
+	const V y(re);
+	t.verify_equal(y.real(), re);
+	t.verify_equal(y.imag(), RV());
+	// swapping real and imaginary parts is a permute of the interleaved layout
+	t.verify_equal(V(x.imag(), x.real()), V([&](int i) { return T(im[i], re[i]); }));
+      }
+    };
+
+    ADD_TEST(mask_from_scalar_abi) {
+      std::array {M([](int i) { return 1 == (i & 1); }), M([](int i) { return 1 == (i % 3); }),
+		  M([](int i) { return 2 < (i % 5); }), M(true), M(false)},
+      [](auto& t, M k) {
+	// one element per register: takes the bit-duplicating conversion to _CxIleav vec-masks
+	using SM = simd::basic_mask<sizeof(T), simd::_Abi_t<V::size(), V::size()>>;
+	if constexpr (std::destructible<SM>)
+	  {
+	    const SM s([&](int i) { return k[i]; });
+	    t.verify_equal(M(s), k);
+	    t.verify_equal(SM(M(s)), s);
+	  }
+      }
+    };
+
+    using CA = simd::complex_vec<T, simd::complex_workload::arithmetic, V::size()>;
+    using CL = simd::complex_vec<T, simd::complex_workload::load_store, V::size()>;
+
+    static_assert(CA::size() == V::size());
+    static_assert(CL::size() == V::size());
+    static_assert(std::is_same_v<typename CA::value_type, T>);
+    static_assert(std::is_same_v<typename CL::value_type, T>);
+    static_assert(std::is_same_v<CL, simd::vec<T, V::size()>>);
+    static_assert(std::is_convertible_v<CA, CL> && std::is_convertible_v<CL, CA>);
+    static_assert(std::is_convertible_v<V, CA> && std::is_convertible_v<CA, V>);
+    static_assert(std::is_same_v<typename simd::complex_vec<T, simd::complex_workload::arithmetic
+							   >::abi_type,
+				 typename simd::complex_vec<T, simd::complex_workload::arithmetic,
+							    simd::vec<T>::size()>::abi_type>);
+
+    ADD_TEST(workload_layouts) {
+      std::tuple {V(re_init, im_init), V(im_init, re_init - Real(1))},
+      [](auto& t, V x, V y) {
+	const CA xa = x;
+	const CA ya = y;
+	const CL xl = x;
+	t.verify_equal(V(xa), x);
+	t.verify_equal(V(xl), x);
+	t.verify_equal(V(CL(xa)), x);
+	t.verify_equal(V(CA(xl)), x);
+	t.verify_equal(RV(xa.real()), x.real());
+	t.verify_equal(RV(xa.imag()), x.imag());
+	t.verify_equal(V(CA(x.real(), x.imag())), x);
+
+	t.verify_equal(V(xa * ya), x * y);
+	t.verify_equal(V(xa + ya), x + y);
+	t.verify_equal(V(xa - ya), x - y);
+	t.verify_equal(V(conj(xa)), conj(x));
+	t.verify_equal(RV(norm(xa)), norm(x));
+	t.verify_equal(M(xa == ya), x == y);
+	t.verify_equal(M(xa == CA(x)), M(true));
+
+	std::array<T, V::size()> mem = {};
+	simd::unchecked_store(xa, mem);
+	for (int i = 0; i < V::size(); ++i)
+	  {
+	    t.verify_equal(mem[i].real(), x[i].real())("i =", i);
+	    t.verify_equal(mem[i].imag(), x[i].imag())("i =", i);
+	  }
+	t.verify_equal(V(simd::unchecked_load<CA>(mem)), x);
+	t.verify_equal(V(simd::unchecked_load<CL>(mem)), x);
+      }
+    };
+  };
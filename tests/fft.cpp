@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+
+// requires complex
+
+#include "unittest.h"
+#include "../include/simd_fft"
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <span>
+#include <vector>
+
+template <typename V>
+  struct Tests {};
+
+template <typename V>
+  requires complex_like<typename V::value_type>
+  struct Tests<V>
+  {
+    using T = typename V::value_type;
+    using R = typename T::value_type;
+    using D = std::complex<double>;
+
+    // powers of two (radix 4 with a final radix 2 pass), mixed radices 2, 3, 4, 5, and other
+    // prime factors (plain DFT passes)
+    static constexpr std::array sizes
+      = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 14, 15, 16, 20, 21, 25, 27, 30, 32, 45, 49, 60,
+	 64, 66, 100, 128};
+
+    static constexpr T
+    x_at(int i)
+    { return T(R(i * 7 % 11 - 5) / R(8), R(i * 5 % 13 - 6) / R(8)); }
+
+    static D
+    to_double(T z)
+    { return D(double(z.real()), double(z.imag())); }
+
+    static std::vector<D>
+    naive_dft(const std::vector<D>& x, double sign)
+    {
+      const int n = x.size();
+      std::vector<D> r(n);
+      for (int k = 0; k < n; ++k)
+	for (int j = 0; j < n; ++j)
+	  {
+	    const double phi = sign * 2 * std::numbers::pi * (j * k % n) / n;
+	    r[k] += x[j] * D(std::cos(phi), std::sin(phi));
+	  }
+      return r;
+    }
+
+    // all inputs have |x| <= 1, thus |X| <= n
+    static bool
+    close(T a, D b, int n)
+    {
+      const double tol = double(std::numeric_limits<R>::epsilon()) * 8 * n;
+      return std::abs(double(a.real()) - b.real()) <= tol
+	       && std::abs(double(a.imag()) - b.imag()) <= tol;
+    }
+
+    // the arrays don't depend on V, only on its value_type: test once per type
+    ADD_TEST(arrays, V::size() == simd::vec<T>::size()) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	if !consteval
+	  {
+	    for (int n : sizes)
+	      {
+		const simd::fft_plan<R> fwd(n);
+		const simd::fft_plan<R> inv(n, simd::fft_direction::inverse);
+		t.verify_equal(fwd.size(), size_t(n));
+		t.verify(inv.direction() == simd::fft_direction::inverse);
+
+		std::vector<T> x(n), y(n), z(n), work(n);
+		std::vector<D> xd(n);
+		for (int i = 0; i < n; ++i)
+		  {
+		    x[i] = x_at(i);
+		    xd[i] = to_double(x[i]);
+		  }
+		const std::vector<D> ref = naive_dft(xd, -1);
+		const std::vector<D> ref_inv = naive_dft(xd, 1);
+
+		fwd(std::span<const T>(x), std::span<T>(y), std::span<T>(work));
+		for (int k = 0; k < n; ++k)
+		  t.verify(close(y[k], ref[k], n))("n =", n, "k =", k);
+
+		// in-place yields the same result as out-of-place
+		z = x;
+		fwd(std::span<T>(z), std::span<T>(work));
+		for (int k = 0; k < n; ++k)
+		  {
+		    t.verify_equal(z[k].real(), y[k].real())("n =", n, "k =", k);
+		    t.verify_equal(z[k].imag(), y[k].imag())("n =", n, "k =", k);
+		  }
+
+		// round trip: the inverse is not normalized
+		inv(std::span<T>(y), std::span<T>(work));
+		for (int k = 0; k < n; ++k)
+		  t.verify(close(y[k], xd[k] * double(n), n))("n =", n, "k =", k);
+
+		inv(std::span<const T>(x), std::span<T>(z), std::span<T>(work));
+		for (int k = 0; k < n; ++k)
+		  t.verify(close(z[k], ref_inv[k], n))("n =", n, "k =", k);
+	      }
+	  }
+      }
+    };
+
+    ADD_TEST(batched) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	if !consteval
+	  {
+	    for (int n : {1, 2, 3, 4, 5, 6, 7, 8, 12, 15, 16, 22, 30, 32})
+	      {
+		const simd::fft_plan<R> fwd(n);
+		const simd::fft_plan<R> inv(n, simd::fft_direction::inverse);
+		std::vector<V> x(n), y(n), work(n);
+		for (int i = 0; i < n; ++i)
+		  x[i] = V([&](int l) { return x_at(i + 3 * l); });
+
+		fwd(std::span<const V>(x), std::span<V>(y), std::span<V>(work));
+		for (int l = 0; l < V::size(); ++l)
+		  {
+		    std::vector<D> xd(n);
+		    for (int i = 0; i < n; ++i)
+		      xd[i] = to_double(x_at(i + 3 * l));
+		    const std::vector<D> ref = naive_dft(xd, -1);
+		    for (int k = 0; k < n; ++k)
+		      t.verify(close(y[k][l], ref[k], n))("n =", n, "lane", l, "k =", k);
+		  }
+
+		inv(std::span<V>(y), std::span<V>(work));
+		for (int i = 0; i < n; ++i)
+		  for (int l = 0; l < V::size(); ++l)
+		    t.verify(close(y[i][l], to_double(x[i][l]) * double(n), n))
+		      ("n =", n, "lane", l, "i =", i);
+	      }
+	  }
+      }
+    };
+  };
@@ -7,6 +7,11 @@
 
 #include "unittest.h"
 
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 template <typename T, std::size_t N, std::size_t Alignment>
   class alignas(Alignment) aligned_array
     : public std::array<T, N>
@@ -84,6 +89,11 @@ template <typename V>
 	t.verify_equal(simd::unchecked_load<V>(mem, M(false)), V());
 	t.verify_equal(simd::partial_load<V>(mem, M(true)), ref);
 	t.verify_equal(simd::partial_load<V>(mem, M(false)), V());
+
+	t.verify_equal(simd::unchecked_load<V>(mem, simd::__flag_prefetch<4, 16>), ref);
+	constexpr auto aligned_prefetch = simd::flag_aligned | simd::__flag_prefetch<0, 8>;
+	t.verify_equal(simd::unchecked_load<V>(mem, aligned_prefetch), ref);
+	t.verify_equal(simd::unchecked_load<V>(mem, simd::__flag_prefetch<0, 0, 4, 1>), ref);
       }
     };
 
@@ -119,4 +129,123 @@ template <typename V>
 					     simd::flag_convert), ref_k_2);
       }
     };
+
+#if __has_include(<sys/mman.h>)
+    // the range ends at the end of a readable page, which is followed by a PROT_NONE page:
+    // partial loads must not read past the range
+    ADD_TEST(partial_load_page_end, requires {T() + T(1);}) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	if !consteval
+	  {
+	    const size_t page = sysconf(_SC_PAGESIZE);
+	    void* map = mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE,
+			     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	    t.verify(map != MAP_FAILED);
+	    if (map == MAP_FAILED)
+	      return;
+	    char* guard = static_cast<char*>(map) + page;
+	    t.verify_equal(mprotect(guard, page, PROT_NONE), 0);
+	    T* end = reinterpret_cast<T*>(guard);
+	    for (int n = 1; n <= V::size(); ++n)
+	      {
+		T* first = end - n;
+		for (int i = 0; i < n; ++i)
+		  first[i] = T(i + 1);
+		t.verify_equal(simd::partial_load<V>(first, end),
+			       V([&](int i) { return i < n ? T(i + 1) : T(); }))("n =", n);
+		t.verify_equal(simd::partial_load<V>(first, end, alternating),
+			       V([&](int i) { return i < n && (i & 1) ? T(i + 1) : T(); }))
+		  ("n =", n);
+	      }
+	    munmap(map, 2 * page);
+	  }
+      }
+    };
+#endif
+
+    using IV = simd::vec<int, V::size()>;
+    using IM = typename IV::mask_type;
+
+    ADD_TEST(gathers, requires(IV i, std::array<T, 1> a) {
+			       T() + T(1); simd::unchecked_gather_from<V>(a, i); }) {
+      std::tuple {make_iota_array<T>(), make_iota_array<int>(), alternating},
+      [](auto& t, auto mem, auto ints, M k) {
+	const IV reversed([](int i) { return V::size() - 1 - i; });
+	const V ref_rev([](int i) { return T(V::size() - i); });
+	t.verify_equal(simd::unchecked_gather_from<V>(mem, reversed), ref_rev);
+	t.verify_equal(simd::unchecked_gather_from<V>(mem, IM(k), reversed),
+		       select(k, ref_rev, T()));
+	t.verify_equal(simd::unchecked_gather_from<V>(ints, reversed, simd::flag_convert), ref_rev);
+	t.verify_equal(simd::partial_gather_from<V>(mem, reversed), ref_rev);
+
+	// the first index is negative, the last ones are out of bounds for larger V
+	const IV strided([](int i) { return 3 * i - 1; });
+	const V ref_strided([](int i) {
+			      const int j = 3 * i - 1;
+			      return j >= 0 && j < 2 * V::size() ? T(j + 1) : T();
+			    });
+	t.verify_equal(simd::partial_gather_from<V>(mem, strided), ref_strided);
+	t.verify_equal(simd::partial_gather_from<V>(mem, IM(k), strided),
+		       select(k, ref_strided, T()));
+	t.verify_equal(simd::partial_gather_from<V>(ints, strided, simd::flag_convert),
+		       ref_strided);
+	simd::prefetch(mem, reversed);
+	simd::prefetch<simd::prefetch_hint::nta>(mem, 2 * V::size());
+	simd::prefetch<simd::prefetch_hint::t2, true>(ints, reversed + 1);
+	t.verify_equal(simd::unchecked_gather_from<V>(mem, reversed), ref_rev);
+      }
+    };
+
+    ADD_TEST(interleaved, requires(std::array<T, 2 * V::size()> a) {
+				simd::load_interleaved<2, V>(a); }) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	auto check = [&](auto n) {
+	  constexpr std::size_t N = n;
+	  std::array<T, N * V::size()> mem = {};
+	  for (std::size_t i = 0; i < mem.size(); ++i)
+	    mem[i] = T(i % 97);
+	  const std::array<V, N> soa = simd::load_interleaved<N, V>(mem);
+	  for (std::size_t j = 0; j < N; ++j)
+	    t.verify_equal(soa[j], V([&](int i) { return mem[i * N + j]; }))("N =", N, "j =", j);
+	  t.verify_equal(simd::load_interleaved<N, V>(mem.data())[N - 1], soa[N - 1]);
+
+	  std::array<T, N * V::size()> out = {};
+	  simd::store_interleaved(soa, out);
+	  for (std::size_t i = 0; i < mem.size(); ++i)
+	    t.verify_equal(out[i], mem[i])("N =", N, "i =", i);
+	  out = {};
+	  simd::store_interleaved(soa, out.begin());
+	  for (std::size_t i = 0; i < mem.size(); ++i)
+	    t.verify_equal(out[i], mem[i])("N =", N, "i =", i);
+	};
+	check(std::cw<2>);
+	check(std::cw<3>);
+	check(std::cw<4>);
+	check(std::cw<8>);
+      }
+    };
+
+    ADD_TEST(padded, requires(simd::padded_vector<T> a) { simd::partial_load<V>(a); }) {
+      std::tuple {test_iota<V, 1, 0>},
+      [](auto& t, const V v) {
+	for (int n = 0; n <= V::size; ++n)
+	  {
+	    simd::padded_vector<T> mem(n, T(-1));
+	    if !consteval
+	      {
+		t.verify_equal(reinterpret_cast<std::uintptr_t>(mem.data()) % 64, std::uintptr_t());
+	      }
+	    simd::partial_store(v, mem);
+	    for (int i = 0; i < n; ++i)
+	      t.verify_equal(mem[i], v[i])("n =", n, "i =", i);
+	    const V x = simd::partial_load<V>(mem);
+	    for (int i = 0; i < V::size; ++i)
+	      t.verify_equal(x[i], i < n ? v[i] : T())("n =", n, "i =", i);
+	    if (n > 0 && V::size * sizeof(T) <= 64) // all of V is allocated
+	      t.verify_equal(simd::partial_load<V>(mem.data(), n, simd::__flag_padded), x);
+	  }
+      }
+    };
   };
@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+// requires float
+
+#include "unittest.h"
+
+// Tests the ifunc entry points of libsimd. Only meaningful with -DVIR_MATH_DISPATCH (see 'make
+// check-vir-math-dispatch').
+#if VIR_PATCH_MATH && VIR_MATH_DISPATCH && defined __x86_64__
+template <typename V>
+  struct Tests
+  {
+    using T = typename V::value_type;
+
+    // once per type and arch suffices
+    static constexpr bool applicable
+      = V::size() == 1 && (std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+    /// The best math ABI the CPU supports (see archv* in the Makefile).
+    static int
+    expected_level()
+    {
+      __builtin_cpu_init();
+      // the v4 kernels are compiled with -mavx512fp16
+      if (__builtin_cpu_supports("x86-64-v4") && __builtin_cpu_supports("avx512fp16"))
+	return 4;
+      else if (__builtin_cpu_supports("x86-64-v3"))
+	return 3;
+      else if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("sse4.2")
+		 && __builtin_cpu_supports("popcnt"))
+	return 2;
+      else if (__builtin_cpu_supports("sse4.1"))
+	return 1;
+      else
+	return 0;
+    }
+
+    ADD_TEST(selected_level, applicable) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	if !consteval
+	  {
+	    const int level = simd::__math_dispatch_level();
+	    t.verify_equal(level, expected_level());
+	    if (!__builtin_cpu_supports("avx512fp16"))
+	      t.verify(level < 4)("AVX-512 without FP16 must not select the v4 kernels");
+	  }
+      }
+    };
+
+    ADD_TEST(dispatched_kernel, applicable) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	if !consteval
+	  {
+	    using W = simd::vec<T, 16 / sizeof(T)>;
+	    using TV = simd::__vec_builtin_type<T, W::size()>;
+	    constexpr simd::_OptTraits precise{0};
+	    constexpr simd::_ArchTraits levels[] = {
+	      simd::_ArchTraits{simd::_ArchTraits::_S_math_abi_v1},
+	      simd::_ArchTraits{simd::_ArchTraits::_S_math_abi_v2},
+	      simd::_ArchTraits{simd::_ArchTraits::_S_math_abi_v3a},
+	      simd::_ArchTraits{simd::_ArchTraits::_S_math_abi_v3b},
+	      simd::_ArchTraits{simd::_ArchTraits::_S_math_abi_v4}
+	    };
+	    constexpr simd::_TargetTraits dispatch
+	      = {simd::_ArchTraits{simd::_ArchTraits::_S_math_abi_dispatch}, precise};
+
+	    const int level = simd::__math_dispatch_level();
+	    // values where the kernels of different levels may round differently (FMA)
+	    const TV x = std::bit_cast<TV>((test_iota<W> + T(1)) * T(1.1));
+	    const TV y = std::bit_cast<TV>((test_iota<W> + T(3)) / T(7));
+	    const TV r = simd::__hypot<dispatch, TV>(x, y);
+	    template for (constexpr int i : std::_IotaArray<std::size(levels)>)
+	      if (i == level)
+		{
+		  const TV ref = simd::__hypot<simd::_TargetTraits{levels[i], precise}, TV>(x, y);
+		  t.verify_equal(std::bit_cast<W>(r), std::bit_cast<W>(ref))("level:", level);
+		}
+	  }
+      }
+    };
+  };
+#endif
@@ -0,0 +1,185 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright © 2026      GSI Helmholtzzentrum fuer Schwerionenforschung GmbH
+ *                       Matthias Kretz <m.kretz@gsi.de>
+ */
+// requires float
+
+#include "unittest.h"
+#include "../include/bits/simd_math_kernels.h"
+
+// Tests the kernels that VIR_MATH_INLINE inlines into the callers directly, independent of
+// whether the PCH was built with VIR_MATH_INLINE.
+#if VIR_PATCH_MATH
+template <typename V>
+  struct Tests
+  {
+    using T = typename V::value_type;
+
+    using L = std::numeric_limits<T>;
+
+    static constexpr T denorm_min = L::denorm_min();
+    static constexpr T norm_min = L::min();
+    static constexpr T max = L::max();
+    static constexpr T inf = L::infinity();
+    static constexpr T nan = L::quiet_NaN();
+    static constexpr T zero = 0;
+
+    // the math functions only use the kernels for single-register vecs (see simd_math.h)
+    static constexpr bool has_kernel = V::size() > 1 && V::abi_type::_S_nreg == 1;
+
+    template <typename X>
+      static X
+      hypot_kernel(const X& x, const X& y)
+      {
+#ifdef __FAST_MATH__
+	return simd::__fast_hypot_kernel(x, y);
+#else
+	return simd::__hypot_kernel<simd::_TargetTraits()._M_math_abi()>(x, y);
+#endif
+      }
+
+    template <typename X>
+      static X
+      hypot_kernel(const X& x, const X& y, const X& z)
+      {
+#ifdef __FAST_MATH__
+	return simd::__fast_hypot_kernel(x, y, z);
+#else
+	return simd::__hypot_kernel<simd::_TargetTraits()._M_math_abi()>(x, y, z);
+#endif
+      }
+
+    static constexpr auto hypot_kernel_special_values = make_math_test {
+      std::array{
+#ifdef __STDC_IEC_559__
+	nan, inf, -inf, -zero, denorm_min, norm_min / 3,
+#endif
+	zero, norm_min, T(1), T(2), max / 5, max / 3, max / 2,
+#ifndef __FAST_MATH__
+	max // fast-math hypot is imprecise for the max exponent
+#endif
+      },
+      has_kernel ? 10000 : 0,
+      [](const auto& x, const auto& y) {
+	if constexpr (std::floating_point<std::remove_cvref_t<decltype(x)>> || !has_kernel)
+	  return std::hypot(x, y);
+	else
+	  return hypot_kernel(x, y);
+      }
+    };
+
+    ADD_TEST(hypot3_kernel, has_kernel) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<3>},
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    // scales: no rescaling needed, tiny (where the squares underflow), and huge (where the
+	    // squares overflow)
+	    for (T s : {T(1), norm_min * T(64), max / T(64)})
+	      {
+		const V a = x * s;
+		const V b = a * T(3);
+		const V c = a / T(7);
+		t.verify_equal_to_ulp(hypot_kernel(a, b, c),
+				      V([&](int i) { return std::hypot(a[i], b[i], c[i]); }),
+				      std::cw<1>)("inputs:", a, b, c);
+		t.verify_equal_to_ulp(hypot_kernel(c, a, b),
+				      V([&](int i) { return std::hypot(c[i], a[i], b[i]); }),
+				      std::cw<1>)("inputs:", c, a, b);
+		// the large difference shortcut
+		t.verify_equal(hypot_kernel(a, c * L::epsilon() * L::epsilon(), V()), a);
+	      }
+#ifdef __STDC_IEC_559__
+	    t.verify_equal(hypot_kernel(x, V(inf), V(nan)), inf);
+	    t.verify_equal(hypot_kernel(V(-inf), x, V()), inf);
+	    t.verify(all_of(isnan(hypot_kernel(x, V(nan), x))));
+	    const V d = x * denorm_min;
+	    t.verify_equal_to_ulp(hypot_kernel(d, d, d),
+				  V([&](int i) { return std::hypot(d[i], d[i], d[i]); }),
+				  std::cw<1>)("input:", d);
+#endif
+	  }
+      }
+    };
+
+#ifdef __AVX512FP16__
+    /**
+     * Compares @p kernel against @p ref computed in float (and rounded to _Float16) for the
+     * _Float16 values with bit patterns in [@p first, @p last].
+     */
+    static void
+    check_f16_kernel(auto& t, unsigned first, unsigned last, auto ulp, auto kernel, auto ref)
+    {
+      for (unsigned b = first; b <= last; b += V::size())
+	{
+	  const V x([&](int i) {
+		      return std::bit_cast<T>(static_cast<unsigned short>(std::min(b + i, last)));
+		    });
+	  t.verify_equal_to_ulp(kernel(x), V([&](int i) { return T(ref(float(x[i]))); }), ulp)(
+	    "input:", x);
+	}
+    }
+
+    // the error bounds of the kernels (see __f16_kernel_max_ulp) over all inputs where the result
+    // is normal (exp) or where the kernel doesn't fall back to float (sin, cos)
+    ADD_TEST(f16_kernels, std::is_same_v<T, _Float16> && V::size() == simd::vec<T>::size()) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	if !consteval
+	  {
+	    using simd::_TargetTraits;
+	    const auto exp_k = [](const V& x) {
+	      return simd::__f16_exp_kernel<_TargetTraits()>(x);
+	    };
+	    const auto exp_r = [](float x) { return std::exp(x); };
+	    check_f16_kernel(t, 0x0000, 0x4980, std::cw<1>, exp_k, exp_r); // [0, 11]
+	    check_f16_kernel(t, 0x8000, 0xc8c0, std::cw<1>, exp_k, exp_r); // [-9.5, -0]
+
+	    check_f16_kernel(t, 0x0001, 0x7bff, std::cw<2>, [](const V& x) {
+			       return simd::__f16_log_kernel<_TargetTraits()>(x);
+			     }, [](float x) { return std::log(x); });
+
+	    for (unsigned sign : {0x0000u, 0x8000u}) // |x| <= 256
+	      {
+		check_f16_kernel(t, sign, sign | 0x5c00, std::cw<2>, [](const V& x) {
+				   return simd::__f16_sin_kernel<_TargetTraits()>(x);
+				 }, [](float x) { return std::sin(x); });
+		check_f16_kernel(t, sign, sign | 0x5c00, std::cw<4>, [](const V& x) {
+				   return simd::__f16_cos_kernel<_TargetTraits()>(x);
+				 }, [](float x) { return std::cos(x); });
+		check_f16_kernel(t, sign, sign | 0x7bff, std::cw<2>, [](const V& x) {
+				   return simd::__f16_tanh_kernel<_TargetTraits()>(x);
+				 }, [](float x) { return std::tanh(x); });
+	      }
+
+	    check_f16_kernel(t, 0x0001, 0x7bff, std::cw<2>, [](const V& x) {
+			       return simd::__f16_rsqrt_kernel<_TargetTraits()>(x);
+			     }, [](float x) { return 1 / std::sqrt(x); });
+#ifndef __FAST_MATH__
+	    t.verify_equal(simd::__f16_rsqrt_kernel<_TargetTraits()>(V()), inf);
+	    t.verify_equal(simd::__f16_rsqrt_kernel<_TargetTraits()>(V(inf)), V());
+	    t.verify(all_of(isnan(simd::__f16_rsqrt_kernel<_TargetTraits()>(V(T(-1))))));
+#endif
+	  }
+      }
+    };
+
+    // exp always uses its kernel, the kernels with larger errors are opt-in via math_precision
+    ADD_TEST(f16_policies, std::is_same_v<T, _Float16> && V::size() > 1) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<7>},
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    constexpr simd::_TargetTraits p2 = simd::math_precision<2>;
+	    constexpr simd::_TargetTraits p4 = simd::math_precision<4>;
+	    t.verify_equal(simd::exp(x), simd::__f16_exp_kernel<simd::_TargetTraits()>(x));
+	    t.verify_equal(simd::log<p2>(x), simd::__f16_log_kernel<p2>(x));
+	    t.verify_equal(simd::sin<p2>(x), simd::__f16_sin_kernel<p2>(x));
+	    t.verify_equal(simd::tanh<p2>(x), simd::__f16_tanh_kernel<p2>(x));
+	    t.verify_equal(simd::cos<p4>(x), simd::__f16_cos_kernel<p4>(x));
+	  }
+      }
+    };
+#endif
+  };
+#endif
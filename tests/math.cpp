@@ -55,6 +55,18 @@ template <typename V>
 	{
 	  t.verify_equal(nearbyint(x), V([&](int i) { return std::nearbyint(x[i]); }));
 	}
+#if !__FINITE_MATH_ONLY__
+	if !consteval
+	{
+	  V ip;
+	  const V frac = modf(x, &ip);
+	  T ref_ip[V::size()];
+	  const V ref_frac([&](int i) { return std::modf(x[i], &ref_ip[i]); });
+	  t.verify_equal(frac, ref_frac);
+	  t.verify_equal(copysign(V(T(1)), frac), copysign(V(T(1)), ref_frac));
+	  t.verify_equal(ip, V([&](int i) { return ref_ip[i]; }));
+	}
+#endif
       }
     };
 
@@ -69,6 +81,274 @@ template <typename V>
       }
     };
 
+    // sincos, frexp, and remquo return their second result in a register (see __math_return)
+    ADD_TEST(sincos) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<7>},
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    constexpr auto ulp = std::cw<sizeof(T) == 8 ? 3 : 2>;
+	    // the last factor yields (rounded) multiples of π/2, where the reduction falls back to
+	    // the scalar functions
+	    for (T s : {T(1), T(-10), T(100), T(1e-3), T(7 * 1.5707963267948966)})
+	      {
+		const V y = x * s;
+		V sn, cs;
+		sincos(y, &sn, &cs);
+		t.verify_equal_to_ulp(sn, V([&](int i) { return std::sin(y[i]); }), ulp)(
+		  "input:", y);
+		t.verify_equal_to_ulp(cs, V([&](int i) { return std::cos(y[i]); }), ulp)(
+		  "input:", y);
+	      }
+	    if constexpr (sizeof(T) >= 4)
+	      { // |x| >= 2^20 uses the scalar functions
+		const V y = x * T(1e7);
+		V sn, cs;
+		sincos(y, &sn, &cs);
+		t.verify_equal_to_ulp(sn, V([&](int i) { return std::sin(y[i]); }), ulp)(
+		  "input:", y);
+		t.verify_equal_to_ulp(cs, V([&](int i) { return std::cos(y[i]); }), ulp)(
+		  "input:", y);
+	      }
+	    V sn, cs;
+	    sincos(x * T(-0.), &sn, &cs);
+	    t.verify_equal(cs, T(1));
+#ifndef __FAST_MATH__
+	    t.verify_equal(copysign(V(T(1)), sn), T(-1));
+#endif
+#if !__FINITE_MATH_ONLY__
+	    sincos(x * T() + inf, &sn, &cs);
+	    t.verify(all_of(isnan(sn)));
+	    t.verify(all_of(isnan(cs)));
+#endif
+	  }
+      }
+    };
+
+    ADD_TEST(frexp) {
+      make_packed_array<V>(+0., -0., 0.5, -0.5, 1, -1.5, 3, 1000, -1e-3,
+			   before_one, -before_one, after_one, 2 * after_one,
+			   norm_min, -norm_min, max, min
+#ifndef __FAST_MATH__ // subnormals are flushed to zero
+			   , denorm_min, -denorm_min, norm_min / 3
+#endif
+#if !__FINITE_MATH_ONLY__
+			   , inf, -inf, nan
+#endif
+			  ),
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    simd::rebind_t<int, V> e;
+	    const V m = frexp(x, &e);
+	    int ref_e[V::size()] = {};
+	    const V ref_m([&](int i) { return std::frexp(x[i], &ref_e[i]); });
+	    t.verify_equal(m, ref_m)("input:", x);
+	    t.verify_equal(copysign(V(T(1)), m), copysign(V(T(1)), ref_m))("input:", x);
+	    t.verify_equal(e, simd::rebind_t<int, V>([&](int i) { return ref_e[i]; }))(
+	      "input:", x);
+	  }
+      }
+    };
+
+    ADD_TEST(remquo) {
+      std::tuple {(test_iota<V> + std::cw<1>) * std::cw<7> / std::cw<3>},
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    using IV = simd::rebind_t<int, V>;
+	    // x / 1 hits the halfway cases (round to even)
+	    const V halves = (test_iota<V> + T(1)) * T(.5);
+	    for (const V& a : {x, -x * T(100), halves, -halves})
+	      for (T s : {T(1), T(-1.5), T(.375), T(3), T(1e-3)})
+		{
+		  const V b = s;
+		  IV quo;
+		  const V r = remquo(a, b, &quo);
+		  int ref_q[V::size()] = {};
+		  const V ref_r([&](int i) { return std::remquo(a[i], b[i], &ref_q[i]); });
+		  t.verify_equal(r, ref_r)("inputs:", a, b);
+		  t.verify_equal(copysign(V(T(1)), r), copysign(V(T(1)), ref_r))("inputs:", a, b);
+		  // only the sign and the three low bits of the quotient are specified
+		  t.verify_equal(quo % 8, IV([&](int i) { return ref_q[i] % 8; }))(
+		    "inputs:", a, b);
+		}
+#if !__FINITE_MATH_ONLY__
+	    const V z = x * T();
+	    IV quo;
+	    t.verify(all_of(isnan(remquo(x, z, &quo))));
+	    t.verify(all_of(isnan(remquo(z + inf, x, &quo))));
+	    t.verify_equal(remquo(x, z - inf, &quo), x);
+#endif
+	  }
+      }
+    };
+
+#if defined __FAST_MATH__ && defined __x86_64__ && defined __GLIBC__
+    // With -ffast-math, glibc declares simd-clones (libmvec) for these functions. Every width
+    // must reach them: 8-byte vecs are padded for the call, odd widths (e.g. 3, 6, 12) use a
+    // padded register, and multi-register vecs call the clone once per register.
+    ADD_TEST(simd_clones, std::is_same_v<T, float> || std::is_same_v<T, double>) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<7>},
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    constexpr auto ulp = std::cw<4>; // documented maximum error of libmvec
+	    t.verify_equal_to_ulp(exp(x), V([&](int i) { return std::exp(x[i]); }), ulp)(
+	      "input: {}", x);
+	    t.verify_equal_to_ulp(log(x), V([&](int i) { return std::log(x[i]); }), ulp)(
+	      "input: {}", x);
+	    t.verify_equal_to_ulp(sin(x), V([&](int i) { return std::sin(x[i]); }), ulp)(
+	      "input: {}", x);
+	    t.verify_equal_to_ulp(cos(x), V([&](int i) { return std::cos(x[i]); }), ulp)(
+	      "input: {}", x);
+	    const V y = x + T(1);
+	    t.verify_equal_to_ulp(pow(x, y), V([&](int i) { return std::pow(x[i], y[i]); }), ulp)(
+	      "input: {}, {}", x, y);
+	  }
+      }
+    };
+#endif
+
+    ADD_TEST(precision_policies) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<3>},
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    for (T s : {T(1), norm_min * T(64), max / T(64)})
+	      {
+		const V a = x * s;
+		const V b = a * T(3);
+		const V ref([&](int i) { return std::hypot(a[i], b[i]); });
+		t.verify_equal_to_ulp(simd::hypot<simd::math_precision<1>>(a, b), ref, std::cw<1>)(
+		  "inputs:", a, b);
+		t.verify_equal_to_ulp(simd::hypot<simd::math_precision<4>>(a, b), ref, std::cw<4>)(
+		  "inputs:", a, b);
+		if (s == T(1)) // fast_math is imprecise close to the limits of the exponent
+		  t.verify_equal_to_ulp(simd::hypot<simd::fast_math>(a, b), ref, std::cw<4>)(
+		    "inputs:", a, b);
+	      }
+	    if constexpr (std::is_same_v<T, float>)
+	      { // 3 ULP allow sqrt via rsqrt
+		const V y = x * T(0x1p-20);
+		const V ref([&](int i) { return std::sqrt(y[i]); });
+		t.verify_equal(simd::sqrt<simd::math_precision<1>>(y), ref)("input:", y);
+		t.verify_equal_to_ulp(simd::sqrt<simd::math_precision<4>>(y), ref, std::cw<3>)(
+		  "input:", y);
+	      }
+#if !__FINITE_MATH_ONLY__
+	    // only fast_math may assume finite values
+	    const V z = x * T();
+	    t.verify_equal(simd::hypot<simd::math_precision<1>>(x, z + inf), inf);
+	    t.verify_equal(simd::hypot<simd::math_precision<4>>(z - inf, x), inf);
+	    t.verify_equal(simd::hypot<simd::math_precision<4>>(z + nan, z + inf), inf);
+	    t.verify(all_of(isnan(simd::hypot<simd::math_precision<1>>(x, z + nan))));
+	    t.verify(all_of(isnan(simd::hypot<simd::math_precision<4>>(z + nan, x))));
+	    const V d = x * denorm_min;
+	    t.verify_equal_to_ulp(simd::hypot<simd::math_precision<4>>(d, d),
+				  V([&](int i) { return std::hypot(d[i], d[i]); }), std::cw<4>)(
+	      "input:", d);
+	    t.verify_equal(simd::sqrt<simd::math_precision<4>>(z + inf), inf);
+	    t.verify_equal(simd::sqrt<simd::math_precision<4>>(-z), -z);
+	    t.verify(all_of(isnan(simd::sqrt<simd::math_precision<4>>(z - x))));
+	    t.verify_equal_to_ulp(simd::sqrt<simd::math_precision<4>>(d),
+				  V([&](int i) { return std::sqrt(d[i]); }), std::cw<3>)(
+	      "input:", d);
+#endif
+	  }
+      }
+    };
+
+    ADD_TEST(rcp_rsqrt) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<3>},
+      [](auto& t, V x) {
+	// double uses rcp14/rsqrt14 with AVX-512, and division otherwise
+	constexpr auto ulp = std::cw<sizeof(T) == 8 ? 4 : 2>;
+	t.verify_equal_to_ulp(rcp<2>(x), V([&](int i) -> T { return T(1) / x[i]; }), ulp)(
+	  "input: {}", x);
+	t.verify_equal_to_ulp(rsqrt<2>(x), V([&](int i) -> T { return T(1) / std::sqrt(x[i]); }),
+			      ulp)("input: {}", x);
+#if !__FINITE_MATH_ONLY__
+	const V zero = x * T();
+	t.verify_equal(rcp<1>(zero), inf);
+	t.verify_equal(rsqrt<1>(zero), inf);
+	t.verify_equal(rsqrt<1>(zero + inf), zero);
+#endif
+      }
+    };
+
+    ADD_TEST(rcp_rsqrt_range, std::is_same_v<T, double>) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<3>},
+      [](auto& t, V x) {
+	// far outside of float's range: an estimate in float would return 0 or inf
+	for (T s : {T(1e300), T(1e-300), T(0x1p-1000)})
+	  {
+	    const V y = x * s;
+	    t.verify_equal_to_ulp(rcp<2>(y), V([&](int i) -> T { return T(1) / y[i]; }),
+				  std::cw<4>)("input: {}", y);
+	    t.verify_equal_to_ulp(rsqrt<2>(y),
+				  V([&](int i) -> T { return T(1) / std::sqrt(y[i]); }),
+				  std::cw<4>)("input: {}", y);
+	  }
+      }
+    };
+
+    // sqrt and operator/ use rsqrtps/rcpps with -freciprocal-math and approximate math
+    ADD_TEST(approx_sqrt_div, std::is_same_v<T, float>) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<3>},
+      [](auto& t, V x) {
+	if !consteval
+	  {
+	    const V y = x * T(0x1p-20);
+	    t.verify_equal_to_ulp(simd::sqrt<simd::fast_math>(y),
+				  V([&](int i) { return std::sqrt(y[i]); }), std::cw<3>)(
+	      "input: {}", y);
+#ifndef __FAST_MATH__ // subnormals are flushed to zero
+	    const V d = x * denorm_min * T(1000);
+	    t.verify_equal_to_ulp(simd::sqrt<simd::fast_math>(d),
+				  V([&](int i) { return std::sqrt(d[i]); }), std::cw<3>)(
+	      "input: {}", d);
+#else
+	    // the divisors cross the limits of the range where rcpps is precise
+	    for (auto [n, s] : std::array<std::pair<T, T>, 3> {{{T(0x1p100), T(0x1p122)},
+								{T(0x1p-100), T(0x1p-128)},
+								{T(3), T(1)}}})
+	      {
+		const V num = n;
+		const V den = x * s;
+		t.verify_equal_to_ulp(num / den, V([&](int i) { return num[i] / den[i]; }),
+				      std::cw<3>)("inputs:", num, den);
+	      }
+#endif
+	  }
+      }
+    };
+
+    ADD_TEST(polynomial) {
+      std::tuple {(test_iota<V> + std::cw<1>) / std::cw<7>},
+      [](auto& t, V x) {
+	static constexpr std::array c = {1., 1., 1. / 2, 1. / 6, 1. / 24, 1. / 120, 1. / 720};
+	const V ref([&](int i) {
+		      T r = T(c.back());
+		      for (int j = c.size() - 2; j >= 0; --j)
+			r = r * x[i] + T(c[j]);
+		      return r;
+		    });
+	t.verify_equal_to_ulp(horner<c>(x), ref, std::cw<1>)("input: {}", x);
+	t.verify_equal_to_ulp(estrin<c>(x), ref, std::cw<2>)("input: {}", x);
+	t.verify_equal_to_ulp(polynomial<c>(x), ref, std::cw<2>)("input: {}", x);
+	const auto [a, b] = polynomial<1., 2., 3.>(x, x + T(1));
+	t.verify_equal_to_ulp(a, T(1) + x * (T(2) + x * T(3)), std::cw<1>)("input: {}", x);
+	t.verify_equal_to_ulp(b, polynomial<1., 2., 3.>(x + T(1)), std::cw<0>)("input: {}", x);
+	// several coefficient sets on the same input
+	static constexpr std::array s = {0., 1., 0., -1. / 6, 0., 1. / 120};
+	static constexpr std::array k = {1., 0., -1. / 2, 0., 1. / 24};
+	const auto [ps, pk] = polynomial<s, k>(x);
+	t.verify_equal_to_ulp(ps, horner<s>(x), std::cw<2>)("input: {}", x);
+	t.verify_equal_to_ulp(pk, horner<k>(x), std::cw<2>)("input: {}", x);
+      }
+    };
+
     static constexpr auto hypot_special_values = make_math_test {
       std::array{
 #ifdef __STDC_IEC_559__
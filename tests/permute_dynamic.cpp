@@ -9,9 +9,10 @@
 template <typename V>
   struct Tests
   {
-#if VIR_PATCH_PERMUTE_DYNAMIC
     using T = typename V::value_type;
     using M = typename V::mask_type;
+
+#if VIR_PATCH_PERMUTE_DYNAMIC
     using P = simd::rebind_t<int, V>;
 
     ADD_TEST(shufN) {
@@ -54,5 +55,48 @@ template <typename V>
       }
     };
 
+    using P16 = simd::resize_t<16, P>;
+    using V16 = simd::resize_t<16, V>;
+    ADD_TEST(lookup, requires(V x, P perm) { lookup(x, perm); }) {
+      std::tuple{V([](int i) { return T(i + 1); }), P([](int i) { return int(P::size()) - 1 - i; }),
+		 P16([](int i) { return (i * 5) % int(V::size()); })},
+      [](auto& t, V x, P perm, P16 perm16) {
+	t.verify_equal(lookup(x, perm), x[perm]);
+	t.verify_equal(lookup(x, perm16), x[perm16]);
+	std::array<T, V::size()> mem = {};
+	for (int i = 0; i < V::size(); ++i)
+	  mem[i] = x[i];
+	t.verify_equal(lookup(mem, perm), x[perm]);
+	t.verify_equal(lookup(std::span<const T>(mem), perm16), x[perm16]);
+      }
+    };
 #endif
+
+    ADD_TEST(compress_expand, requires(V x, M k) { compress(x, k); }) {
+      std::tuple{V([](int i) { return T(i + 1); }), M([](int i) { return i % 3 != 1; })},
+      [](auto& t, V x, M k) {
+	const int n = reduce_count(k);
+	std::array<T, V::size()> c = {}, e = {};
+	for (int i = 0, j = 0; i < V::size(); ++i)
+	  {
+	    e[i] = k[i] ? x[j] : x[i];
+	    if (k[i])
+	      c[j++] = x[i];
+	  }
+	const V ref_c([&](int i) { return c[i]; });
+	const V ref_e([&](int i) { return e[i]; });
+	const M first_n([&](int i) { return i < n; });
+	t.verify_equal(select(first_n, compress(x, k), T()), ref_c);
+	t.verify_equal(compress(x, k, T()), ref_c);
+	t.verify_equal(compress(x, M(true), T()), x);
+	t.verify_equal(compress(x, M(false), T(3)), V(T(3)));
+	t.verify_equal(expand(x, k, x), ref_e);
+	t.verify_equal(expand(x, k), select(k, ref_e, T()));
+	t.verify_equal(expand(compress(x, k), k, x), x);
+	t.verify_equal(compress(k, k), first_n);
+	t.verify_equal(compress(!k, k, true), !first_n);
+	t.verify_equal(expand(first_n, k), k);
+	t.verify_equal(expand(M(false), k, !k), !k);
+      }
+    };
   };
@@ -104,4 +104,161 @@ template <typename V>
 	  }
       }
     };
+
+    using IV = simd::vec<int, V::size()>;
+    using IM = typename IV::mask_type;
+
+    ADD_TEST(scatters, requires(V v, IV i, std::array<T, 1> a) {
+			 simd::unchecked_scatter_to(v, a, i); }) {
+      std::tuple {test_iota<V, 1, 0>, alternating},
+      [](auto& t, const V v, const M al) {
+	alignas(256) std::array<T, V::size * 2> mem = {};
+	const IV reversed([](int i) { return V::size() - 1 - i; });
+	simd::unchecked_scatter_to(v, mem, reversed);
+	for (int i = 0; i < V::size; ++i)
+	  t.verify_equal(mem[i], T(V::size - i))("i =", i);
+
+	mem = {};
+	simd::unchecked_scatter_to(v, mem, IM(al), reversed);
+	for (int i = 0; i < V::size; ++i)
+	  t.verify_equal(mem[i], (V::size - 1 - i) % 2 ? T(V::size - i) : T())("i =", i);
+
+	// the first index is negative, the last ones are out of bounds for larger V
+	mem = {};
+	simd::partial_scatter_to(v, mem, IV([](int i) { return 3 * i - 1; }));
+	for (int i = 0; i < 2 * V::size; ++i)
+	  t.verify_equal(mem[i], (i + 1) % 3 == 0 ? T((i + 1) / 3 + 1) : T())("i =", i);
+
+	// colliding indices: the last element wins
+	mem = {};
+	simd::unchecked_scatter_to(v, mem, IV([](int i) { return i / 2; }));
+	for (int i = 0; i < V::size; ++i)
+	  t.verify_equal(mem[i], i < (V::size + 1) / 2 ? T(std::min(2 * i + 2, int(V::size)))
+						       : T())("i =", i);
+      }
+    };
+
+    ADD_TEST(compress_stores, requires(V v, M k, T* p) { simd::compress_store(v, k, p); }) {
+      std::tuple {test_iota<V, 1, 0>, alternating},
+      [](auto& t, const V v, const M al) {
+	constexpr int n_odd = V::size / 2;
+	constexpr int n_even = V::size - n_odd;
+	std::array<T, V::size * 2> mem = {};
+	auto it = simd::compress_store(v, al, mem.begin());
+	t.verify_equal(int(it - mem.begin()), n_odd);
+	// enough room for a full store
+	it = simd::compress_store(v, !al, it, mem.end());
+	t.verify_equal(int(it - mem.begin()), V::size);
+	for (int i = 0; i < n_odd; ++i)
+	  t.verify_equal(mem[i], T(2 * i + 2))("i =", i);
+	for (int i = 0; i < n_even; ++i)
+	  t.verify_equal(mem[n_odd + i], T(2 * i + 1))("i =", i);
+
+	// no room for more than the selected elements
+	mem = {};
+	it = simd::compress_store(v, al, mem.begin(), mem.begin() + n_odd);
+	t.verify_equal(int(it - mem.begin()), n_odd);
+	for (int i = 0; i < 2 * V::size; ++i)
+	  t.verify_equal(mem[i], i < n_odd ? T(2 * i + 2) : T())("i =", i);
+
+	it = simd::compress_store(v, M(false), mem.begin(), mem.begin());
+	t.verify_equal(int(it - mem.begin()), 0);
+      }
+    };
+
+    ADD_TEST(streaming, requires(V v, std::array<T, 1> a) {
+			  simd::unchecked_store(v, a, simd::__flag_streaming); }) {
+      std::tuple {test_iota<V, 1, 0>},
+      [](auto& t, const V v) {
+	alignas(256) std::array<T, V::size * 2> mem = {};
+	simd::unchecked_store(v, mem, simd::__flag_streaming);
+	// unaligned: falls back to a regular store
+	simd::unchecked_store(v, mem.begin() + 1, mem.end(), simd::__flag_streaming);
+	if !consteval
+	  {
+	    simd::__streaming_fence();
+	  }
+	t.verify_equal(mem[0], v[0]);
+	for (int i = 0; i < V::size; ++i)
+	  t.verify_equal(mem[i + 1], v[i])("i =", i);
+	t.verify_equal(simd::unchecked_load<V>(mem.begin() + 1, mem.end(), simd::__flag_streaming),
+		       v);
+	t.verify_equal(simd::unchecked_load<V>(mem, simd::__flag_streaming)[0], v[0]);
+      }
+    };
+
+    // the pattern documented at __flag_streaming: regular stores until the output is aligned,
+    // non-temporal stores for the rest, and a fence before reading the data
+    ADD_TEST(streaming_copy, requires(V v, std::array<T, 1> a) {
+			       simd::unchecked_store(v, a, simd::__flag_streaming); }) {
+      std::tuple {V()},
+      [](auto& t, V) {
+	constexpr int n = 4 * V::size + 3;
+	alignas(256) std::array<T, n + 1> src = {}, dst = {};
+	for (int i = 0; i < n; ++i)
+	  src[i + 1] = T(i % 61 + 1);
+	auto in = src.begin() + 1;
+	auto out = dst.begin() + 1;
+	if !consteval
+	  {
+	    const auto misaligned = [](auto it) {
+	      return reinterpret_cast<std::uintptr_t>(std::to_address(it)) % simd::alignment_v<V>;
+	    };
+	    for (; out != dst.end() && misaligned(out); ++in, ++out)
+	      *out = *in;
+	  }
+	for (; dst.end() - out >= V::size(); in += V::size(), out += V::size())
+	  simd::unchecked_store(simd::unchecked_load<V>(in, src.end(), simd::__flag_streaming),
+				out, dst.end(), simd::__flag_streaming);
+	simd::partial_store(simd::partial_load<V>(in, src.end()), out, dst.end());
+	if !consteval
+	  {
+	    simd::__streaming_fence();
+	  }
+	t.verify_equal(dst[0], T());
+	for (int i = 1; i <= n; ++i)
+	  t.verify_equal(dst[i], src[i])("i =", i);
+      }
+    };
+
+    ADD_TEST(read_modify_write, requires(V v, M k, std::array<T, 1> a) {
+			  simd::unchecked_store(v, a, k, simd::__flag_read_modify_write); }) {
+      std::tuple {test_iota<V, 1, 0>, alternating},
+      [](auto& t, const V v, const M al) {
+	std::array<T, V::size * 2> mem = {};
+	mem.fill(T(-1));
+	simd::unchecked_store(v, mem.begin() + 1, mem.end(), al, simd::__flag_read_modify_write);
+	t.verify_equal(mem[0], T(-1));
+	for (int i = 0; i < V::size; ++i)
+	  t.verify_equal(mem[i + 1], i % 2 ? T(i + 1) : T(-1))("i =", i);
+	for (int i = V::size + 1; i < 2 * V::size; ++i)
+	  t.verify_equal(mem[i], T(-1))("i =", i);
+	// output range smaller than the vec: ignores the flag
+	simd::unchecked_store(v, mem.begin(), mem.begin() + 1, M(true),
+			      simd::__flag_read_modify_write | simd::__allow_partial_loadstore);
+	t.verify_equal(mem[0], T(1));
+	t.verify_equal(mem[1], T(-1));
+      }
+    };
+
+    // every tail length, which uses vmaskmov / vpmaskmov with AVX for 4- and 8-byte elements
+    ADD_TEST(partial_stores) {
+      std::tuple {test_iota<V, 1, 0>, alternating},
+      [](auto& t, const V v, const M al) {
+	for (int n = 0; n <= V::size(); ++n)
+	  {
+	    std::array<T, V::size * 2> mem = {};
+	    simd::partial_store(v, mem.begin() + 1, mem.begin() + 1 + n);
+	    t.verify_equal(mem[0], T())("n =", n);
+	    for (int i = 0; i < 2 * V::size() - 1; ++i)
+	      t.verify_equal(mem[i + 1], i < n ? v[i] : T())("n =", n, "i =", i);
+
+	    mem = {};
+	    simd::partial_store(v, mem.begin() + 1, mem.begin() + 1 + n, al);
+	    t.verify_equal(mem[0], T())("n =", n);
+	    for (int i = 0; i < 2 * V::size() - 1; ++i)
+	      t.verify_equal(mem[i + 1], i < n && al[i] ? v[i] : T())("n =", n, "i =", i);
+	  }
+      }
+    };
   };